@@ -37,6 +37,18 @@ extern "C" {
 #endif
 
 
+/* Result kinds of HexowlCalculate */
+#define HEXOWL_RESULT_NONE		0	/* no value or an error in decVal */
+#define HEXOWL_RESULT_TEXT		1	/* other type, decVal, hexVal and binVal are formatted */
+#define HEXOWL_RESULT_STRING	2	/* decVal */
+#define HEXOWL_RESULT_BOOL		3	/* decVal */
+#define HEXOWL_RESULT_UINT		4	/* rawVal */
+#define HEXOWL_RESULT_INT		5	/* rawVal is the two's complement */
+#define HEXOWL_RESULT_FLOAT		6	/* rawVal is the IEEE 754 bits */
+
+/* Flags of a native builtin */
+#define HEXOWL_NATIVE_IMPURE	1	/* reaches the SD card, the screen or the CPU governor, refused in a preview */
+
 /* Return type for HexowlCalculate */
 typedef struct hexowl_calculate_return {
 	GoUint8 success; /* success */
@@ -44,8 +56,42 @@ typedef struct hexowl_calculate_return {
 	GoString hexVal; /* hexVal */
 	GoString binVal; /* binVal */
 	GoUint32 calcTime;	/* calcTime */
+	GoUint8 interrupted; /* interrupted */
+	GoUint8 kind;		/* kind */
+	GoUint64 rawVal;	/* rawVal */
 } hexowl_calculate_return_t;
 
+/* Return type for HexowlCalculateBatch */
+typedef struct hexowl_calculate_batch_return {
+	GoUint32 lines;		/* evaluated lines */
+	GoUint32 failed;	/* lines with an error */
+	GoUint8 interrupted; /* interrupted */
+} hexowl_calculate_batch_return_t;
+
+/* Argument and return value of a native builtin */
+typedef struct hexowl_value {
+	GoUint8 kind;		/* HEXOWL_RESULT_UINT, _INT, _FLOAT, _BOOL or _STRING */
+	GoUint64 raw;		/* number bits as in rawVal, bool is 0 or 1 */
+	GoString str;		/* string argument valid during the call only, or the string result */
+} hexowl_value_t;
+
+/* Go runtime memory and GC statistics, pauses are in microseconds */
+typedef struct hexowl_stats {
+	GoUint64 heapInuse;		/* heap in use */
+	GoUint64 heapSys;		/* heap system size */
+	GoUint64 totalAlloc;	/* cumulative allocations */
+	GoUint32 lastGcPause;	/* last pause of a HexowlCollect collection */
+	GoUint32 maxGcPause;	/* max pause of a HexowlCollect collection */
+	GoUint64 calcAlloc;		/* allocations during the last HexowlCalculate or HexowlCalculateBatch */
+} hexowl_stats_t;
+
+/* Durations of the last calculation phases in microseconds, parse and generate are 0 on a parse cache hit */
+typedef struct hexowl_phases {
+	GoUint32 parse;		/* ParsePrompt */
+	GoUint32 generate;	/* operators.Generate */
+	GoUint32 calculate;	/* operators.Calculate */
+} hexowl_phases_t;
+
 typedef void (*hexowl_print_func_t)(GoString str);
 typedef void (*hexowl_clear_func_t)(void);
 typedef int (*hexowl_flist_func_t)(char *str);
@@ -53,9 +99,25 @@ typedef int (*hexowl_fopen_func_t)(GoString name, GoString mode);
 typedef int (*hexowl_fclose_func_t)(void);
 typedef int (*hexowl_fwrite_func_t)(const void *data, size_t size);
 typedef int (*hexowl_fread_func_t)(void *data, size_t size);
+/* writes the text of the perf builtin into buf, returns its length */
+typedef int (*hexowl_perf_func_t)(char *buf, size_t size);
+/* returns NULL on success or a static error message, a string result must stay valid until the next call */
+typedef const char *(*hexowl_native_func_t)(const hexowl_value_t *args, int argc, hexowl_value_t *ret);
+/* line is counted from 1, input and the result strings are valid only during the call */
+typedef void (*hexowl_result_func_t)(GoUint32 line, GoString input, const hexowl_calculate_return_t *result);
 
 //go:noinline
-extern hexowl_calculate_return_t HexowlCalculate(const char *input);
+extern hexowl_calculate_return_t HexowlCalculate(GoString input);
+
+/* Evaluate newline separated expressions in one call, blank lines are skipped,
+   every result is passed to resultfunc and an interrupt stops the rest of the batch */
+//go:noinline
+extern hexowl_calculate_batch_return_t HexowlCalculateBatch(GoString input, hexowl_result_func_t resultfunc);
+
+/* Same as HexowlCalculate but refuses inputs that assign, declare or call anything but
+   a pure native builtin; a result that tried to reach a host hook is reported as an error */
+//go:noinline
+extern hexowl_calculate_return_t HexowlPreview(GoString input);
 
 //go:noinline
 extern void HexowlInit(
@@ -72,6 +134,39 @@ extern void HexowlInit(
 //go:noinline
 extern GoUint64 GetFreeMem();
 
+//go:noinline
+extern void HexowlStats(hexowl_stats_t *stats);
+
+/* Register a builtin implemented in C, call after HexowlInit; at most 8 arguments, flags are HEXOWL_NATIVE_* */
+//go:noinline
+extern void HexowlRegisterNative(GoString name, GoString args, GoString desc, GoUint8 min_args, GoUint8 max_args, GoUint8 flags, hexowl_native_func_t nativefunc);
+
+//go:noinline
+extern void HexowlPhases(hexowl_phases_t *phases);
+
+//go:noinline
+extern void HexowlSetPerfFunc(hexowl_perf_func_t perffunc);
+
+/* Collect garbage if the heap usage is above threshold percent, returns the pause in microseconds or 0 */
+//go:noinline
+extern GoUint32 HexowlCollect(GoUint8 threshold);
+
+/* Buffer of a request slot in the Go heap, pass the one the slot has or NULL at first;
+   the same buffer comes back unless a cached tree kept the input it holds, the
+   slot takes the new one then and never touches the old one again */
+//go:noinline
+extern char *HexowlInputBuffer(char *buf, GoUint32 size);
+
+/* Abort the running HexowlCalculate, safe to call from any task; the interrupt is seen
+   before every expression and at every builtin and host hook call, a user function
+   recursing without any of them runs on */
+//go:noinline
+extern void HexowlInterrupt();
+
+/* Clear the interrupt before a request, it stays set for all its calculations */
+//go:noinline
+extern void HexowlBeginRequest();
+
 #ifdef __cplusplus
 }
 #endif
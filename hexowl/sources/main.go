@@ -3,7 +3,10 @@ package main
 import (
 	"fmt"
 	"io"
+	"math"
 	"runtime"
+	"strings"
+	"sync/atomic"
 	"time"
 	"unsafe"
 
@@ -28,6 +31,44 @@ typedef int (*fclose_func_t)(void);
 typedef int (*fwrite_func_t)(const void* data, size_t size);
 typedef int (*fread_func_t)(void* data, size_t size);
 
+typedef struct {
+	uint8_t success;
+	_GoString_ decVal;
+	_GoString_ hexVal;
+	_GoString_ binVal;
+	uint32_t calcTime;
+	uint8_t interrupted;
+	uint8_t kind;
+	uint64_t rawVal;
+} hexowl_result_t;
+
+typedef void (*result_func_t)(uint32_t line, _GoString_ input, const hexowl_result_t *result);
+
+typedef int (*perf_func_t)(char *buf, size_t size);
+
+typedef struct {
+	uint8_t kind;
+	uint64_t raw;
+	_GoString_ str;
+} hexowl_value_t;
+
+typedef const char *(*native_func_t)(const hexowl_value_t *args, int argc, hexowl_value_t *ret);
+
+typedef struct {
+	uint32_t parse;
+	uint32_t generate;
+	uint32_t calculate;
+} hexowl_phases_t;
+
+typedef struct {
+	uint64_t heapInuse;
+	uint64_t heapSys;
+	uint64_t totalAlloc;
+	uint32_t lastGcPause;
+	uint32_t maxGcPause;
+	uint64_t calcAlloc;
+} hexowl_stats_t;
+
 void ExtPrint(uintptr_t func, _GoString_ str)
 {
 	if (func == 0) return;
@@ -58,6 +99,24 @@ int ExtWriteFile(uintptr_t func, _GoSlice_ data)
 	return ((fwrite_func_t)func)(data.data, data.len);
 }
 
+void ExtResult(uintptr_t func, uint32_t line, _GoString_ input, const hexowl_result_t *result)
+{
+	if (func == 0) return;
+	((result_func_t)func)(line, input, result);
+}
+
+int ExtPerf(uintptr_t func, _GoSlice_ buf)
+{
+	if (func == 0) return -8;
+	return ((perf_func_t)func)(buf.data, buf.len);
+}
+
+const char *ExtNative(uintptr_t func, const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+	if (func == 0) return "not implemented";
+	return ((native_func_t)func)(args, argc, ret);
+}
+
 int ExtReadFile(uintptr_t func, _GoSlice_ data)
 {
 	if (func == 0) return -8;
@@ -78,7 +137,13 @@ const (
 	ERR_SD_NOT_IMPLEMENTED = -8
 )
 
-type displayWriter struct{}
+// size of the staging buffer the display writer strips escapes into
+const printChunkSize = 256
+
+type displayWriter struct {
+	escDet bool
+	buf    [printChunkSize]byte
+}
 
 type envWriter struct{}
 
@@ -93,6 +158,7 @@ var funcsDescriptor struct {
 	closeFunc  uintptr
 	writeFunc  uintptr
 	readFunc   uintptr
+	perfFunc   uintptr
 }
 
 var errorMessages = map[int]error{
@@ -108,6 +174,87 @@ var errorMessages = map[int]error{
 
 var stdOut displayWriter
 
+var errInterrupted = fmt.Errorf("interrupted")
+var errSideEffect = fmt.Errorf("side effects are not allowed in preview")
+
+// set while a preview is evaluated, every host hook is refused then
+// and the attempt is recorded, so the preview result is never reused
+var previewMode bool
+var previewTouched bool
+
+// hexowl builtins that only compute their result from the arguments
+var pureBuiltins = []string{
+	"sin", "cos", "tan", "asin", "acos", "atan", "sqrt", "pow", "exp", "logn", "log2", "log10",
+	"round", "ceil", "floor", "hex",
+}
+
+// hexowl builtins with effects that leave the user functions as they are; rmfunc,
+// clfuncs, load and import change them and are not here, nor is any user function
+var funcSafeBuiltins = []string{
+	"help", "clear", "print", "println", "vars", "clvars", "funcs", "save", "rand", "randf",
+	"mem", "stats", "cache", "perf",
+}
+
+// the calls a preview may contain, the pure builtins: a user function may assign,
+// print or recurse without an end, and so may the other hexowl builtins
+var previewCalls = makeSet(pureBuiltins)
+
+// the calls that keep the parse cache, the native builtins are added when registered
+var cacheCalls = makeSet(pureBuiltins, funcSafeBuiltins)
+
+// functions declared by an input, a call to one of them is a user function call
+// even if a builtin of the lists above has the same name
+var declaredFuncs = map[string]bool{}
+
+// operators of the input, the longest ones first, and those that change a variable or a function
+var previewOperators = []string{"<<=", ">>=", "->", ":=", "==", "!=", "<=", ">=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<", ">>", "&&", "||"}
+var previewAssignments = map[string]bool{"=": true, "<<=": true, ">>=": true, "->": true, ":=": true, "+=": true, "-=": true, "*=": true, "/=": true, "%=": true, "&=": true, "|=": true, "^=": true}
+
+var interruptDescriptor struct {
+	flag uint32
+}
+
+// generated operator trees of the recently evaluated inputs
+const parseCacheSize = 16
+
+type parseCacheEntry struct {
+	input    string
+	operator *operators.Operator
+	lastUse  uint32
+}
+
+var parseCache struct {
+	entries [parseCacheSize]parseCacheEntry
+	tick    uint32
+	hits    uint32
+	misses  uint32
+	flushes uint32
+}
+
+// request slot buffers of the calc task: a tree generated from one of them keeps
+// the buffer instead of a copy of the input, the slot gets a new one then
+var inputSlots [][]byte
+
+// the slot buffer taken over last, the other lines of a batch in it need no copy either
+var adoptedInput []byte
+
+// durations of the last calculation phases in microseconds,
+// parsing and generation are zero when the tree came from the cache
+var phaseTimes struct {
+	parse     uint32
+	generate  uint32
+	calculate uint32
+}
+
+// collections triggered from here, pauses are in microseconds; the collections the
+// runtime runs by itself are not counted, neither runtime tells about them
+var gcStats struct {
+	idleCount uint32
+	lastPause uint32
+	maxPause  uint32
+	calcAlloc uint64
+}
+
 func toCstr(str string) C._GoString_ {
 	return *(*C._GoString_)(unsafe.Pointer(&str))
 }
@@ -116,54 +263,89 @@ func toCslice(slc []byte) C._GoSlice_ {
 	return *(*C._GoSlice_)(unsafe.Pointer(&slc))
 }
 
-func removeAnsi(arr []byte) string {
-	retArr := make([]byte, 0, len(arr))
-	escDet := false
-	for _, c := range arr {
-		if c == '\u001B' {
-			escDet = true
-			continue
-		}
-		if escDet && c != 'm' {
-			continue
-		}
-		if escDet && c == 'm' {
-			escDet = false
-			continue
-		}
-		retArr = append(retArr, c)
+// checkInterrupt is called from every host hook reachable during an evaluation,
+// hooks are refused in a preview
+func checkInterrupt() error {
+	if err := checkAbort(); err != nil {
+		return err
 	}
-	return string(retArr)
+	if previewMode {
+		previewTouched = true
+		return errSideEffect
+	}
+
+	return nil
+}
+
+// checkAbort is called before every expression and from every builtin and hook;
+// the evaluator of hexowl has no callback of its own, so a user function that
+// recurses or loops without calling any of them is not stopped
+func checkAbort() error {
+	if atomic.LoadUint32(&interruptDescriptor.flag) != 0 {
+		return errInterrupted
+	}
+
+	return nil
+}
+
+func isInterrupted() bool {
+	return atomic.LoadUint32(&interruptDescriptor.flag) != 0
 }
 
 func (w *displayWriter) Write(arr []byte) (n int, err error) {
 	if funcsDescriptor.printFunc == 0 || funcsDescriptor.printLimit == 0 {
 		return 0, fmt.Errorf("print function does not defined")
 	}
+	if err = checkInterrupt(); err != nil {
+		return 0, err
+	}
 
-	var strToPrint string
+	limit := len(w.buf)
+	if funcsDescriptor.printLimit < limit {
+		limit = funcsDescriptor.printLimit
+	}
 
-	sizeLeft := len(arr)
-	for sizeLeft > funcsDescriptor.printLimit {
-		// skip ASNI ESC color code
-		strToPrint = removeAnsi(arr[n : n+funcsDescriptor.printLimit])
+	// skip ANSI ESC color codes, the escape state survives between calls
+	// so a sequence split across two writes is still stripped
+	fill := 0
+	for _, c := range arr {
+		if w.escDet {
+			if c == 'm' {
+				w.escDet = false
+			}
+			continue
+		}
+		if c == '\u001B' {
+			w.escDet = true
+			continue
+		}
 
-		C.ExtPrint(funcsDescriptor.printFunc, toCstr(strToPrint))
-		sizeLeft -= funcsDescriptor.printLimit
-		n += funcsDescriptor.printLimit
+		w.buf[fill] = c
+		fill++
+		if fill == limit {
+			w.flush(fill)
+			fill = 0
+		}
 	}
 
-	// skip ASNI ESC color code
-	strToPrint = removeAnsi(arr[n : n+sizeLeft])
-	C.ExtPrint(funcsDescriptor.printFunc, toCstr(strToPrint))
+	if fill > 0 {
+		w.flush(fill)
+	}
 
-	return n, nil
+	return len(arr), nil
+}
+
+func (w *displayWriter) flush(size int) {
+	C.ExtPrint(funcsDescriptor.printFunc, toCstr(unsafe.String(&w.buf[0], size)))
 }
 
 func (e *envWriter) Write(data []byte) (n int, err error) {
 	if funcsDescriptor.closeFunc == 0 {
 		return 0, fmt.Errorf("not implemented write function")
 	}
+	if err = checkInterrupt(); err != nil {
+		return 0, err
+	}
 
 	n = int(C.ExtWriteFile(funcsDescriptor.writeFunc, toCslice(data)))
 	if n < 0 {
@@ -189,6 +371,9 @@ func (e *envReader) Read(data []byte) (n int, err error) {
 	if funcsDescriptor.closeFunc == 0 {
 		return 0, fmt.Errorf("not implemented read function")
 	}
+	if err = checkInterrupt(); err != nil {
+		return 0, err
+	}
 
 	n = int(C.ExtReadFile(funcsDescriptor.readFunc, toCslice(data)))
 	if n < 0 {
@@ -210,54 +395,435 @@ func (e *envReader) Close() error {
 	return nil
 }
 
+// result kinds, keep in sync with HEXOWL_RESULT_* in hexowl.h
+const (
+	resultNone uint8 = iota
+	resultText
+	resultString
+	resultBool
+	resultUint
+	resultInt
+	resultFloat
+)
+
+type calcResult struct {
+	success     bool
+	decVal      string
+	hexVal      string
+	binVal      string
+	calcTime    uint32
+	interrupted bool
+	kind        uint8
+	rawVal      uint64
+}
+
 //export HexowlCalculate
 //go:noinline
-func HexowlCalculate(inputStr *C.char) (success bool, decVal, hexVal, binVal string, calcTime uint32) {
-	input := C.GoString(inputStr)
+func HexowlCalculate(input string) (success bool, decVal, hexVal, binVal string, calcTime uint32, interrupted bool, kind uint8, rawVal uint64) {
+	// input is a view into the caller's buffer, valid only during this call; only
+	// a request slot buffer of HexowlInputBuffer is kept, by generateOperator
+	allocBegin := sampleAlloc()
+	r := calculate(input, make(map[string]interface{}))
+	recordCalcAlloc(allocBegin)
+
+	return r.success, r.decVal, r.hexVal, r.binVal, r.calcTime, r.interrupted, r.kind, r.rawVal
+}
+
+//export HexowlCalculateBatch
+//go:noinline
+func HexowlCalculateBatch(input string, resultFunc uintptr) (lines, failed uint32, interrupted bool) {
+	// newline separated expressions share one call, the locals map is set up once for all of them
+	locals := make(map[string]interface{})
+	allocBegin := sampleAlloc()
+	defer recordCalcAlloc(allocBegin)
+
+	for line := uint32(1); len(input) > 0; line++ {
+		text := input
+		if n := strings.IndexByte(input, '\n'); n >= 0 {
+			text, input = input[:n], input[n+1:]
+		} else {
+			input = ""
+		}
+
+		text = strings.TrimRight(text, "\r")
+		if len(strings.TrimSpace(text)) == 0 {
+			continue
+		}
+
+		for k := range locals {
+			delete(locals, k)
+		}
+
+		r := calculate(text, locals)
+		lines++
+		if !r.success {
+			failed++
+		}
+
+		if resultFunc != 0 {
+			cr := C.hexowl_result_t{
+				success:     C.uint8_t(boolToUint8(r.success)),
+				decVal:      toCstr(r.decVal),
+				hexVal:      toCstr(r.hexVal),
+				binVal:      toCstr(r.binVal),
+				calcTime:    C.uint32_t(r.calcTime),
+				interrupted: C.uint8_t(boolToUint8(r.interrupted)),
+				kind:        C.uint8_t(r.kind),
+				rawVal:      C.uint64_t(r.rawVal),
+			}
+			C.ExtResult(C.uintptr_t(resultFunc), C.uint32_t(line), toCstr(text), &cr)
+		}
+
+		if r.interrupted {
+			interrupted = true
+			break
+		}
+	}
+
+	return
+}
+
+// sampleAlloc reads the allocation counter, once before and once after a calculation
+// call and not per line, the memory statistics of tinygo walk the whole heap
+func sampleAlloc() uint64 {
+	var stats runtime.MemStats
+	runtime.ReadMemStats(&stats)
+	return stats.TotalAlloc
+}
 
+// recordCalcAlloc keeps the allocations of the call begun at the begin sample,
+// a preview is not a calculation of the user and keeps the previous value
+func recordCalcAlloc(begin uint64) {
+	if !previewMode {
+		gcStats.calcAlloc = sampleAlloc() - begin
+	}
+}
+
+func boolToUint8(b bool) uint8 {
+	if b {
+		return 1
+	}
+	return 0
+}
+
+func calculate(input string, locals map[string]interface{}) (r calcResult) {
 	calcBeginTime := time.Now()
-	words := utils.ParsePrompt(input)
+	phaseTimes.calculate = 0
 
-	operator, err := operators.Generate(words, make(map[string]interface{}))
+	operator, err := generateOperator(input)
 	if err != nil {
-		calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
-		decVal = fmt.Sprintf("%s", err)
+		r.calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
+		r.decVal = fmt.Sprintf("%s", err)
 		return
 	}
 
-	val, err := operators.Calculate(operator, make(map[string]interface{}))
+	// an interrupt that came before this expression stops it, so a Ctrl+C
+	// between two lines or two script chunks is not lost
+	var val interface{}
+	calculateBegin := time.Now()
+	if err = checkAbort(); err == nil {
+		val, err = operators.Calculate(operator, locals)
+	}
+	phaseTimes.calculate = uint32(time.Since(calculateBegin).Microseconds())
+	invalidateParseCache(input)
+	if isInterrupted() {
+		r.calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
+		r.decVal = errInterrupted.Error()
+		r.interrupted = true
+		return
+	}
 	if err != nil {
-		calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
-		decVal = fmt.Sprintf("%s", err)
+		r.calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
+		r.decVal = fmt.Sprintf("%s", err)
 		return
 	}
 
-	calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
-	success = true
+	r.calcTime = uint32(time.Since(calcBeginTime).Milliseconds())
+	r.success = true
 
 	if val == nil {
 		return
 	}
 
+	// numbers are returned raw and formatted on the C side only when printed
 	switch v := val.(type) {
 	case string:
-		decVal = v
+		r.kind = resultString
+		r.decVal = v
 	case bool:
-		decVal = fmt.Sprintf("%v", v)
+		r.kind = resultBool
+		r.decVal = fmt.Sprintf("%v", v)
+	case uint64:
+		r.kind = resultUint
+		r.rawVal = v
+	case int64:
+		r.kind = resultInt
+		r.rawVal = uint64(v)
+	case float64:
+		r.kind = resultFloat
+		r.rawVal = math.Float64bits(v)
 	default:
-		decVal = fmt.Sprintf("%v", val)
-		hexVal = fmt.Sprintf("0x%X", utils.ToNumber[uint64](val))
-		binVal = fmt.Sprintf("0b%b", utils.ToNumber[uint64](val))
+		r.kind = resultText
+		r.decVal = fmt.Sprintf("%v", val)
+		r.hexVal = fmt.Sprintf("0x%X", utils.ToNumber[uint64](val))
+		r.binVal = fmt.Sprintf("0b%b", utils.ToNumber[uint64](val))
+	}
+
+	return
+}
+
+//export HexowlPreview
+//go:noinline
+func HexowlPreview(input string) (success bool, decVal, hexVal, binVal string, calcTime uint32, interrupted bool, kind uint8, rawVal uint64) {
+	if e := scanEffects(input); e.assigns || e.declares || e.calls {
+		decVal = errSideEffect.Error()
+		return
+	}
+
+	previewMode = true
+	previewTouched = false
+	defer func() {
+		previewMode = false
+	}()
+
+	success, decVal, hexVal, binVal, calcTime, interrupted, kind, rawVal = HexowlCalculate(input)
+
+	// a refused hook may have been ignored by the evaluator, the result
+	// would differ from the real calculation then, so it is not a result
+	if previewTouched {
+		success, decVal, hexVal, binVal, kind, rawVal = false, errSideEffect.Error(), "", "", resultNone, 0
+	}
+
+	return
+}
+
+// what an input may change, as far as its tokens tell
+type inputEffects struct {
+	assigns      bool   // assigns a variable
+	declares     bool   // declares a user function
+	calls        bool   // calls anything but a pure builtin
+	changesFuncs bool   // calls a user function or a builtin that changes them
+	declared     string // name of the declared function
+}
+
+func makeSet(lists ...[]string) map[string]bool {
+	set := make(map[string]bool)
+	for _, list := range lists {
+		for _, name := range list {
+			set[name] = true
+		}
+	}
+	return set
+}
+
+// scanEffects splits the input into the tokens the parser sees and reports what
+// they may change; the generated operator tree is opaque outside of hexowl,
+// so the tokens are checked, by the preview and by the parse cache
+func scanEffects(input string) (e inputEffects) {
+	lastCall := ""
+
+	for i := 0; i < len(input); {
+		c := input[i]
+
+		switch {
+		case isSpace(c):
+			i++
+		case isIdentStart(c):
+			begin := i
+			for i < len(input) && isIdentChar(input[i]) {
+				i++
+			}
+			next := i
+			for next < len(input) && isSpace(input[next]) {
+				next++
+			}
+			if next < len(input) && input[next] == '(' {
+				name := input[begin:i]
+				user := declaredFuncs[name] || !cacheCalls[name]
+				if user || !previewCalls[name] {
+					e.calls = true
+				}
+				if user {
+					e.changesFuncs = true
+				}
+				lastCall = name
+			}
+		case c >= '0' && c <= '9':
+			for i < len(input) && (isIdentChar(input[i]) || input[i] == '.') {
+				i++
+			}
+		case c == '"' || c == '\'':
+			for i++; i < len(input) && input[i] != c; i++ {
+				if input[i] == '\\' {
+					i++
+				}
+			}
+			i++
+		default:
+			op := input[i : i+1]
+			for _, o := range previewOperators {
+				if strings.HasPrefix(input[i:], o) {
+					op = o
+					break
+				}
+			}
+			if op == "->" {
+				e.declares = true
+				e.declared = lastCall
+			} else if previewAssignments[op] {
+				e.assigns = true
+			}
+			i += len(op)
+		}
 	}
 
 	return
 }
 
+func isSpace(c byte) bool {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n'
+}
+
+func isIdentStart(c byte) bool {
+	return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+}
+
+func isIdentChar(c byte) bool {
+	return isIdentStart(c) || (c >= '0' && c <= '9')
+}
+
+//export HexowlInterrupt
+//go:noinline
+func HexowlInterrupt() {
+	atomic.StoreUint32(&interruptDescriptor.flag, 1)
+}
+
+//export HexowlBeginRequest
+//go:noinline
+func HexowlBeginRequest() {
+	// the interrupt stays set for all the calls of one request, a script
+	// or a batch, and is cleared only when the next request begins
+	atomic.StoreUint32(&interruptDescriptor.flag, 0)
+}
+
+func generateOperator(input string) (*operators.Operator, error) {
+	key := strings.TrimSpace(input)
+
+	phaseTimes.parse = 0
+	phaseTimes.generate = 0
+
+	parseCache.tick++
+	oldest := 0
+	for i := range parseCache.entries {
+		e := &parseCache.entries[i]
+		if e.operator != nil && e.input == key {
+			e.lastUse = parseCache.tick
+			parseCache.hits++
+			return e.operator, nil
+		}
+		if e.lastUse < parseCache.entries[oldest].lastUse {
+			oldest = i
+		}
+	}
+	parseCache.misses++
+
+	// the words, and with them the cached tree, may point into the input, so the
+	// tree takes over the request slot buffer it is in, any other input is copied
+	if !adoptInputSlot(key) {
+		key = strings.Clone(key)
+	}
+
+	parseBegin := time.Now()
+	words := utils.ParsePrompt(key)
+	generateBegin := time.Now()
+	operator, err := operators.Generate(words, make(map[string]interface{}))
+	phaseTimes.parse = uint32(generateBegin.Sub(parseBegin).Microseconds())
+	phaseTimes.generate = uint32(time.Since(generateBegin).Microseconds())
+	if err != nil {
+		return nil, err
+	}
+
+	parseCache.entries[oldest] = parseCacheEntry{
+		input:    key,
+		operator: operator,
+		lastUse:  parseCache.tick,
+	}
+
+	return operator, nil
+}
+
+// adoptInputSlot takes the request slot buffer the input lies in away from the
+// slots, HexowlInputBuffer gives the calc task a new one for it
+func adoptInputSlot(input string) bool {
+	if len(input) == 0 {
+		return false
+	}
+
+	p := uintptr(unsafe.Pointer(unsafe.StringData(input)))
+	if inBuffer(p, adoptedInput) {
+		return true
+	}
+	for i, buf := range inputSlots {
+		if inBuffer(p, buf) {
+			adoptedInput = buf
+			inputSlots[i] = inputSlots[len(inputSlots)-1]
+			inputSlots = inputSlots[:len(inputSlots)-1]
+			return true
+		}
+	}
+
+	return false
+}
+
+func inBuffer(p uintptr, buf []byte) bool {
+	if len(buf) == 0 {
+		return false
+	}
+	begin := uintptr(unsafe.Pointer(&buf[0]))
+	return p >= begin && p < begin+uintptr(len(buf))
+}
+
+//export HexowlInputBuffer
+//go:noinline
+func HexowlInputBuffer(buf *C.char, size uint32) *C.char {
+	// the buffer stays with the slot unless a cached tree took it over
+	for _, slot := range inputSlots {
+		if unsafe.Pointer(&slot[0]) == unsafe.Pointer(buf) {
+			return buf
+		}
+	}
+
+	slot := make([]byte, size)
+	inputSlots = append(inputSlots, slot)
+	return (*C.char)(unsafe.Pointer(&slot[0]))
+}
+
+// invalidateParseCache drops every cached tree after an input that declared a function
+// or called anything that may: a user function, rmfunc, clfuncs, load or import.
+// Variables are looked up when a tree is calculated, an assignment keeps the trees
+func invalidateParseCache(input string) {
+	e := scanEffects(input)
+	if e.declared != "" {
+		declaredFuncs[e.declared] = true
+	}
+	if e.declares || e.changesFuncs {
+		parseCache.entries = [parseCacheSize]parseCacheEntry{}
+		parseCache.flushes++
+	}
+}
+
 func clearOutput() {
+	if checkInterrupt() != nil {
+		return
+	}
 	C.ExtClear(funcsDescriptor.clearFunc)
 }
 
 func envRead(name string) (io.ReadCloser, error) {
+	if err := checkInterrupt(); err != nil {
+		return nil, err
+	}
+
 	errCode := C.ExtOpenFile(funcsDescriptor.openFunc, toCstr(name), toCstr("r"))
 	if errCode < 0 {
 		err, ok := errorMessages[int(errCode)]
@@ -271,6 +837,10 @@ func envRead(name string) (io.ReadCloser, error) {
 }
 
 func envWrite(name string) (io.WriteCloser, error) {
+	if err := checkInterrupt(); err != nil {
+		return nil, err
+	}
+
 	errCode := C.ExtOpenFile(funcsDescriptor.openFunc, toCstr(name), toCstr("w"))
 	if errCode < 0 {
 		err, ok := errorMessages[int(errCode)]
@@ -312,12 +882,160 @@ func HexowlInit(fmversion *C.char, printlimit uint32, printfunc, clearfunc, list
 		Desc: "show free RAM",
 		Exec: displayFreeMem,
 	})
+	builtin.RegisterFunction("stats", types.Func{
+		Args: "",
+		Desc: "show memory and GC statistics",
+		Exec: displayStats,
+	})
+	builtin.RegisterFunction("cache", types.Func{
+		Args: "",
+		Desc: "show parse cache statistics",
+		Exec: displayParseCache,
+	})
+	builtin.RegisterFunction("perf", types.Func{
+		Args: "",
+		Desc: "show min/median/p99 time of the calculation phases",
+		Exec: displayPerf,
+	})
+}
+
+// arguments a native builtin can take at most
+const maxNativeArgs = 8
+
+// flags of a native builtin, keep in sync with HEXOWL_NATIVE_* in hexowl.h
+const (
+	nativeImpure uint8 = 1 << iota
+)
+
+//export HexowlRegisterNative
+//go:noinline
+func HexowlRegisterNative(name, args, desc string, minArgs, maxArgs, flags uint8, nativefunc uintptr) {
+	// the strings are views into C memory that may not outlive the call
+	name = strings.Clone(name)
+	if maxArgs > maxNativeArgs {
+		maxArgs = maxNativeArgs
+	}
+
+	builtin.RegisterFunction(name, types.Func{
+		Args: strings.Clone(args),
+		Desc: strings.Clone(desc),
+		Exec: nativeExec(name, minArgs, maxArgs, flags, nativefunc),
+	})
+	cacheCalls[name] = true
+	if flags&nativeImpure == 0 {
+		previewCalls[name] = true
+	}
+}
+
+// nativeExec marshals the builtin arguments into C values and the C result back
+func nativeExec(name string, minArgs, maxArgs, flags uint8, nativefunc uintptr) func(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
+	return func(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
+		var cargs [maxNativeArgs]C.hexowl_value_t
+		var ret C.hexowl_value_t
+
+		// an impure builtin is a host hook like any other, a pure one only checks the interrupt
+		check := checkAbort
+		if flags&nativeImpure != 0 {
+			check = checkInterrupt
+		}
+		if err := check(); err != nil {
+			return nil, err
+		}
+
+		if len(args) < int(minArgs) || len(args) > int(maxArgs) {
+			if minArgs == maxArgs {
+				return nil, fmt.Errorf("%s: expected %d arguments", name, minArgs)
+			}
+			return nil, fmt.Errorf("%s: expected %d to %d arguments", name, minArgs, maxArgs)
+		}
+
+		for i, arg := range args {
+			switch v := arg.(type) {
+			case uint64:
+				cargs[i].kind = C.uint8_t(resultUint)
+				cargs[i].raw = C.uint64_t(v)
+			case int64:
+				cargs[i].kind = C.uint8_t(resultInt)
+				cargs[i].raw = C.uint64_t(v)
+			case float64:
+				cargs[i].kind = C.uint8_t(resultFloat)
+				cargs[i].raw = C.uint64_t(math.Float64bits(v))
+			case bool:
+				cargs[i].kind = C.uint8_t(resultBool)
+				cargs[i].raw = C.uint64_t(boolToUint8(v))
+			case string:
+				cargs[i].kind = C.uint8_t(resultString)
+				cargs[i].str = toCstr(v)
+			default:
+				return nil, fmt.Errorf("%s: unsupported argument type %T", name, arg)
+			}
+		}
+
+		if msg := C.ExtNative(C.uintptr_t(nativefunc), &cargs[0], C.int(len(args)), &ret); msg != nil {
+			return nil, fmt.Errorf("%s: %s", name, C.GoString(msg))
+		}
+
+		switch uint8(ret.kind) {
+		case resultUint:
+			return uint64(ret.raw), nil
+		case resultInt:
+			return int64(ret.raw), nil
+		case resultFloat:
+			return math.Float64frombits(uint64(ret.raw)), nil
+		case resultBool:
+			return ret.raw != 0, nil
+		case resultString:
+			return strings.Clone(ret.str), nil
+		}
+
+		return nil, nil
+	}
+}
+
+//export HexowlSetPerfFunc
+//go:noinline
+func HexowlSetPerfFunc(perffunc uintptr) {
+	funcsDescriptor.perfFunc = perffunc
+}
+
+//export HexowlPhases
+//go:noinline
+func HexowlPhases(phases *C.hexowl_phases_t) {
+	phases.parse = C.uint32_t(phaseTimes.parse)
+	phases.generate = C.uint32_t(phaseTimes.generate)
+	phases.calculate = C.uint32_t(phaseTimes.calculate)
+}
+
+//export HexowlCollect
+//go:noinline
+func HexowlCollect(threshold uint8) uint32 {
+	var stats runtime.MemStats
+	runtime.ReadMemStats(&stats)
+
+	if stats.HeapSys == 0 || stats.HeapInuse*100 < stats.HeapSys*uint64(threshold) {
+		return 0
+	}
+
+	gcStats.idleCount++
+	return collectGarbage()
+}
+
+func collectGarbage() uint32 {
+	begin := time.Now()
+	runtime.GC()
+	pause := uint32(time.Since(begin).Microseconds())
+
+	gcStats.lastPause = pause
+	if pause > gcStats.maxPause {
+		gcStats.maxPause = pause
+	}
+
+	return pause
 }
 
 //export GetFreeMem
 //go:noinline
 func GetFreeMem() uint64 {
-	runtime.GC()
 	var stats runtime.MemStats
 	runtime.ReadMemStats(&stats)
 	return stats.Sys - stats.HeapInuse
@@ -326,3 +1044,44 @@ func GetFreeMem() uint64 {
 func displayFreeMem(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
 	return GetFreeMem(), nil
 }
+
+//export HexowlStats
+//go:noinline
+func HexowlStats(stats *C.hexowl_stats_t) {
+	var mem runtime.MemStats
+	runtime.ReadMemStats(&mem)
+
+	stats.heapInuse = C.uint64_t(mem.HeapInuse)
+	stats.heapSys = C.uint64_t(mem.HeapSys)
+	stats.totalAlloc = C.uint64_t(mem.TotalAlloc)
+	stats.lastGcPause = C.uint32_t(gcStats.lastPause)
+	stats.maxGcPause = C.uint32_t(gcStats.maxPause)
+	stats.calcAlloc = C.uint64_t(gcStats.calcAlloc)
+}
+
+func displayStats(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
+	var mem runtime.MemStats
+	runtime.ReadMemStats(&mem)
+
+	return fmt.Sprintf(
+		"heap: %d/%d\nalloc: %d, last calc: %d\nidle gc: %d, pause: %d us, max %d us",
+		mem.HeapInuse, mem.HeapSys,
+		mem.TotalAlloc, gcStats.calcAlloc,
+		gcStats.idleCount, gcStats.lastPause, gcStats.maxPause,
+	), nil
+}
+
+func displayPerf(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
+	var buf [512]byte
+
+	n := int(C.ExtPerf(C.uintptr_t(funcsDescriptor.perfFunc), toCslice(buf[:])))
+	if n < 0 {
+		return nil, errorMessages[n]
+	}
+
+	return string(buf[:n]), nil
+}
+
+func displayParseCache(desc *types.Descriptor, args ...interface{}) (interface{}, error) {
+	return fmt.Sprintf("hits: %d, misses: %d, flushes: %d", parseCache.hits, parseCache.misses, parseCache.flushes), nil
+}
@@ -6,61 +6,191 @@
 #include <esp_log.h>
 #include <esp_ota_ops.h>
 #include <esp_private/esp_clk.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <nvs.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
+#include <freertos/queue.h>
 
 #include <sdcard.h>
+#include <keyboard.h>
 #include <hexowl.h>
 
+#include "ring/ring.h"
+#include "format/numfmt.h"
+#include "perf/perf.h"
+#include "governor/governor.h"
+#include "fastcalc/fastcalc.h"
+#include "native/native.h"
+
 #define INPUT_LEN (1024)
 #define OUTPUT_LEN (4096)
+#define OUTPUT_RING_LEN (8192)
 #define LOCK_TIMEOUT (2500)
+#define GC_IDLE_POLL (250)
+#define PREVIEW_DELAY (150)
+#define PREVIEW_WAKE (0xFF)
+#define GC_HEAP_THRESHOLD (25)
+#define SCRIPT_CHUNK_LEN (4096)
+#define PERF_SAMPLES (64)
+#define SCRIPT_EXT ".hxs"
+#define BIN_GROUP (0) // binary result digits between separators, 0 is none
+
+#define HEAP_MIN_SIZE (256 * 1024)
+#define HEAP_MAX_SIZE (3 * 1024 * 1024)
+#define HEAP_PEAK_HEADROOM (200)
+#define HEAP_PEAK_SAVE_STEP (16 * 1024)
+#define STACK_MIN_SIZE (256 * 1024)
+#define STACK_MAX_SIZE (2 * 1024 * 1024)
+#define PSRAM_RESERVE (512 * 1024)
 
 #define FREQ_HIGH (240)
-#define FREQ_LOW (80)
+#define FREQ_MIN (10)
+#define BOOST_DECAY (3000)
 
 extern void gorun(uintptr_t);
 
-SemaphoreHandle_t calc_begin_sem;
-SemaphoreHandle_t calc_in_lock_mux;
+typedef struct {
+    calc_ticket_t ticket;
+    calc_callback_t callback;
+    bool script;
+    int64_t submit_time;
+    int len;
+    char *input; // INPUT_LEN+1 bytes in the Go heap, see HexowlInputBuffer
+    const char *error; // the request is rejected with this reason, input is empty
+} calc_request_t;
+
+typedef enum {
+    PERF_HANDOFF,
+    PERF_PARSE,
+    PERF_GENERATE,
+    PERF_CALCULATE,
+    PERF_FORMAT,
+    PERF_OUTPUT,
+    PERF_FRAME,
+    PERF_PHASES_COUNT,
+} calc_perf_phase_t;
+
+QueueHandle_t calc_request_queue;
+QueueHandle_t calc_free_queue;
 
 SemaphoreHandle_t calc_out_sem;
-SemaphoreHandle_t calc_out_done_sem;
+SemaphoreHandle_t calc_out_space_sem;
+
+typedef void (*result_write_t)(const char *str, int len);
 
-SemaphoreHandle_t calc_done_sem;
+typedef struct {
+    calc_ticket_t ticket;
+    calc_callback_t callback;
+    uint32_t line_base;
+    uint32_t lines;
+    uint32_t failed;
+    uint32_t max_line;
+    int64_t line_begin;
+    int64_t calc_time;
+    int64_t max_time;
+    int64_t read_time;
+} calc_script_state_t;
+
+// latest edited text, written by the screen and taken by the calc task
+typedef struct {
+    calc_preview_callback_t callback;
+    uint32_t generation;
+    TickType_t due;
+    bool pending;
+    bool wake_sent;
+    int len;
+    char input[INPUT_LEN+1];
+} calc_preview_request_t;
+
+// result of the last preview, owned by the calc task
+typedef struct {
+    bool valid;
+    uint32_t epoch;
+    int len;
+    char input[INPUT_LEN+1];
+    int result_len;
+    char result[OUTPUT_LEN+1];
+} calc_preview_result_t;
 
 static esp_pm_lock_handle_t pm_lock;
-static char input_str[INPUT_LEN+1] = {0};
-static char output_str[OUTPUT_LEN+1] = {0};
-static char general_output_str[OUTPUT_LEN+1] = {0};
-
-static esp_pm_config_t pm_config = {
-    .max_freq_mhz = FREQ_LOW,
-    .min_freq_mhz = 10,
-    .light_sleep_enable = true,
+static calc_request_t requests[CALC_QUEUE_DEPTH];
+static calc_ticket_t last_ticket = 0;
+static const calc_writer_t *output_writer = NULL;
+static ring_t *output_ring;
+static calc_output_stats_t output_stats;
+
+static SemaphoreHandle_t preview_lock;
+static calc_preview_request_t preview_req;
+static calc_preview_result_t preview_res;
+static volatile bool preview_running = false;
+static uint32_t env_epoch = 0;
+
+static perf_t *perf;
+static unsigned int perf_sample;
+// the sample + 1 waiting for the next frame, 0 if none
+static unsigned int perf_frame_sample = 0;
+static int64_t perf_output_time;
+// SPI bytes of every frame, not only the ones after a result
+static uint32_t perf_frames, perf_frame_bytes_last, perf_frame_bytes_max;
+static uint64_t perf_frame_bytes;
+static uint32_t perf_frame_max_us, perf_frames_coalesced;
+static const char *const perf_phase_names[PERF_PHASES_COUNT] = {
+    "handoff", "parse", "generate", "calculate", "format", "output", "frame",
 };
 
-static void set_cpu_freq(uint32_t freq)
-{
-    pm_config.max_freq_mhz = freq;
-    esp_pm_configure(&pm_config);
-    vTaskDelay(50);
-}
+static calc_script_state_t script_state;
+static volatile int script_progress = -1;
+
+static unsigned int heap_size;
+static uint32_t heap_peak;
+static uint32_t heap_peak_saved;
 
 static void hx_print_func(GoString str)
 {
-    ESP_LOGI("calc", "output triggered, len = %u", str.n);
+    const char *data = str.p;
+    size_t left = str.n;
+    size_t written;
+
+    ESP_LOGD("calc", "output triggered, len = %u", str.n);
 
-    if (xSemaphoreTake(calc_out_done_sem, LOCK_TIMEOUT))
+    while (left > 0)
     {
-        memset(general_output_str, 0, INPUT_LEN);
-        memcpy(general_output_str, str.p, str.n);
+        written = ring_write(output_ring, data, left);
+        data += written;
+        left -= written;
+        output_stats.written += written;
+
+        // wake up the consumer, it drains the ring on the next frame
         xSemaphoreGive(calc_out_sem);
+        if (left == 0)
+            break;
+
+        // a signal left from an earlier read may already stand for the space
+        if (xSemaphoreTake(calc_out_space_sem, 0) && ring_free(output_ring) > 0)
+            continue;
+
+        // ring is full: wait until the consumer frees some space
+        ++output_stats.overruns;
+        if (!xSemaphoreTake(calc_out_space_sem, LOCK_TIMEOUT) && ring_free(output_ring) == 0)
+        {
+            ESP_LOGW("calc", "output consumer stalled, %u bytes dropped", left);
+            output_stats.dropped += left;
+            break;
+        }
     }
-    else
+}
+
+static void output_flush(void)
+{
+    // the printed output must land before the result of the same expression
+    while (ring_used(output_ring) > 0)
     {
-        ESP_LOGW("calc", "output resource lock mutex timeout");
+        xSemaphoreGive(calc_out_sem);
+        if (!xSemaphoreTake(calc_out_space_sem, LOCK_TIMEOUT))
+            break;
     }
 }
 
@@ -129,69 +259,667 @@ static int hx_fread_func(void *data, size_t size)
     return sdcard_read(data, size);
 }
 
-static char *str_chain_append(char *dest, const char *source, int len)
+static void output_append(const char *str, int len)
 {
+    if (output_writer == NULL)
+        return;
+
     if (len == 0)
-        len = strlen(source);
+        len = strlen(str);
+
+    int64_t begin_time = esp_timer_get_time();
+    output_writer->write(str, len);
+    perf_output_time += esp_timer_get_time() - begin_time;
+}
+
+static void calc_echo(const char *input, int len)
+{
+    if (output_writer == NULL)
+        return;
+
+    output_writer->begin();
+    output_append(">: ", 0);
+    output_append(input, len);
+    output_append("\n", 0);
+    output_writer->end();
+}
+
+static void calc_reject(const char *reason)
+{
+    if (output_writer == NULL)
+        return;
+
+    output_writer->begin();
+    output_append("<: error: ", 0);
+    output_append(reason, 0);
+    output_append("\n", 0);
+    output_writer->end();
+}
+
+static void preview_append(const char *str, int len)
+{
+    if (len == 0)
+        len = strlen(str);
+
+    if (len > OUTPUT_LEN - preview_res.result_len)
+        len = OUTPUT_LEN - preview_res.result_len;
+
+    memcpy(&preview_res.result[preview_res.result_len], str, len);
+    preview_res.result_len += len;
+    preview_res.result[preview_res.result_len] = 0;
+}
+
+static void format_result(const hexowl_calculate_return_t *vals, result_write_t write)
+{
+    if (vals->interrupted)
+    {
+        write("<: interrupted", 0);
+    }
+    else if (vals->success == 0)
+    {
+        write("<: error: ", 0);
+        write(vals->decVal.p, vals->decVal.n);
+    }
+    else if (vals->kind == HEXOWL_RESULT_UINT || vals->kind == HEXOWL_RESULT_INT || vals->kind == HEXOWL_RESULT_FLOAT)
+    {
+        char buf[NUMFMT_MAX_LEN];
+        uint64_t num = vals->rawVal;
+
+        write("<: ", 0);
+        if (vals->kind == HEXOWL_RESULT_UINT)
+        {
+            write(buf, numfmt_udec(buf, num));
+        }
+        else if (vals->kind == HEXOWL_RESULT_INT)
+        {
+            write(buf, numfmt_dec(buf, (int64_t)num));
+        }
+        else
+        {
+            double f;
+            memcpy(&f, &num, sizeof(f));
+            write(buf, numfmt_float(buf, f));
+            num = numfmt_float_int(f);
+        }
 
-    memcpy(dest, source, len);
-    dest += len;
-    *dest = 0;
-    return dest;
+        write("\n   ", 0);
+        write(buf, numfmt_hex(buf, num));
+        write("\n   ", 0);
+        write(buf, numfmt_bin(buf, num, BIN_GROUP));
+    }
+    else
+    {
+        if (vals->decVal.n > 0)
+        {
+            write("<: ", 0);
+            write(vals->decVal.p, vals->decVal.n);
+        }
+        if (vals->hexVal.n > 0)
+        {
+            write("\n   ", 0);
+            write(vals->hexVal.p, vals->hexVal.n);
+        }
+        if (vals->binVal.n > 0)
+        {
+            write("\n   ", 0);
+            write(vals->binVal.p, vals->binVal.n);
+        }
+    }
+
+    write("\n", 0);
 }
 
-static void calc_begin(void)
+static bool fast_calculate(const char *input, int len, hexowl_calculate_return_t *vals)
+{
+    uint64_t val;
+
+    // plain integer expressions of literals do not need the Go runtime
+    // and have no side effects, so the environment epoch stays the same
+    if (!fastcalc_eval(input, len, &val))
+        return false;
+
+    *vals = (hexowl_calculate_return_t){
+        .success = 1,
+        .kind = HEXOWL_RESULT_UINT,
+        .rawVal = val,
+    };
+    return true;
+}
+
+static void calc_begin(const char *input, int len)
 {
     hexowl_calculate_return_t vals;
-    char *strend = output_str;
+    hexowl_phases_t phases;
+    int64_t begin_time;
+
+    begin_time = esp_timer_get_time();
+    if (fast_calculate(input, len, &vals))
+    {
+        perf_record(perf, perf_sample, PERF_PARSE, 0);
+        perf_record(perf, perf_sample, PERF_GENERATE, 0);
+        perf_record(perf, perf_sample, PERF_CALCULATE, esp_timer_get_time() - begin_time);
+    }
+    else
+    {
+        vals = HexowlCalculate((GoString){input, len});
+        ++env_epoch;
+
+        HexowlPhases(&phases);
+        perf_record(perf, perf_sample, PERF_PARSE, phases.parse);
+        perf_record(perf, perf_sample, PERF_GENERATE, phases.generate);
+        perf_record(perf, perf_sample, PERF_CALCULATE, phases.calculate);
+    }
+
+    if (output_writer == NULL)
+        return;
 
-    vals = HexowlCalculate(input_str);
+    output_flush();
 
-    if (vals.success == 0)
+    // the result strings live in the Go heap until the next call,
+    // so they are written straight into the output storage
+    begin_time = esp_timer_get_time();
+    output_writer->begin();
+    perf_output_time = esp_timer_get_time() - begin_time;
+    format_result(&vals, output_append);
+    int64_t end_time = esp_timer_get_time();
+    output_writer->end();
+    perf_output_time += esp_timer_get_time() - end_time;
+
+    // the writer time is counted apart from formatting
+    perf_record(perf, perf_sample, PERF_FORMAT, esp_timer_get_time() - begin_time - perf_output_time);
+    perf_record(perf, perf_sample, PERF_OUTPUT, perf_output_time);
+}
+
+static int hx_perf_func(char *buf, size_t size)
+{
+    uint32_t min, median, p99;
+    int len;
+    int n;
+
+    len = snprintf(buf, size, "min/median/p99 us");
+    for (int i = 0; i < PERF_PHASES_COUNT && len < size; ++i)
     {
-        strend = str_chain_append(strend, "<: error: ", 0);
-        strend = str_chain_append(strend, vals.decVal.p, vals.decVal.n);
+        n = perf_stats(perf, i, &min, &median, &p99);
+        if (n == 0)
+            len += snprintf(&buf[len], size - len, "\n   %s: -", perf_phase_names[i]);
+        else
+            len += snprintf(&buf[len], size - len, "\n   %s: %u/%u/%u", perf_phase_names[i],
+                            (unsigned int)min, (unsigned int)median, (unsigned int)p99);
     }
+
+    if (len < size && perf_frames > 0)
+        len += snprintf(&buf[len], size - len, "\n   frames: %u, max %u us, %u redraws coalesced",
+                        (unsigned int)perf_frames, (unsigned int)perf_frame_max_us,
+                        (unsigned int)perf_frames_coalesced);
+    if (len < size && perf_frames > 0)
+        len += snprintf(&buf[len], size - len, "\n   frame bytes: last %u, avg %u, max %u",
+                        (unsigned int)perf_frame_bytes_last, (unsigned int)(perf_frame_bytes / perf_frames),
+                        (unsigned int)perf_frame_bytes_max);
+
+    calc_output_stats_t out;
+    calc_get_output_stats(&out);
+    if (len < size)
+        len += snprintf(&buf[len], size - len, "\n   output: %u bytes, %u waits, %u dropped, peak %u of %u",
+                        (unsigned int)out.written, out.overruns, (unsigned int)out.dropped,
+                        (unsigned int)out.high_water, OUTPUT_RING_LEN);
+
+    governor_stats_t gov;
+    governor_get_stats(&gov);
+    if (len < size)
+        len += snprintf(&buf[len], size - len, "\n   cpu: %u MHz %u s, %u-%u MHz %u s, %u boosts, decay %u ms",
+                        (unsigned int)gov.max_mhz, (unsigned int)(gov.boost_ms / 1000),
+                        (unsigned int)gov.min_mhz, (unsigned int)gov.max_mhz, (unsigned int)(gov.scaled_ms / 1000),
+                        gov.boosts, (unsigned int)governor_get_decay());
+
+    return len < size ? len : size - 1;
+}
+
+static void batch_result(GoUint32 line, GoString input, const hexowl_calculate_return_t *vals)
+{
+    if (output_writer == NULL)
+        return;
+
+    output_flush();
+
+    output_writer->begin();
+    output_append(">: ", 0);
+    output_append(input.p, input.n);
+    output_append("\n", 0);
+    format_result(vals, output_append);
+    output_writer->end();
+}
+
+static void calc_batch(const char *input, int len)
+{
+    hexowl_calculate_batch_return_t ret;
+
+    // one evaluator call for all the lines, each result is echoed with its line
+    ret = HexowlCalculateBatch((GoString){input, len}, batch_result);
+    ++env_epoch;
+
+    ESP_LOGI("calc", "batch: %u lines, %u failed%s", (unsigned int)ret.lines, (unsigned int)ret.failed,
+             ret.interrupted ? ", interrupted" : "");
+}
+
+static void script_result(GoUint32 line, GoString input, const hexowl_calculate_return_t *vals)
+{
+    // the line took the time since the previous result, calcTime has only milliseconds
+    int64_t line_time = esp_timer_get_time() - script_state.line_begin;
+
+    line += script_state.line_base;
+
+    ++script_state.lines;
+    script_state.calc_time += line_time;
+    if (line_time > script_state.max_time || script_state.max_line == 0)
+    {
+        script_state.max_time = line_time;
+        script_state.max_line = line;
+    }
+
+    // a library defines a lot of words, only the failed lines are worth showing
+    if (vals->success || output_writer == NULL)
+    {
+        script_state.line_begin = esp_timer_get_time();
+        return;
+    }
+
+    ++script_state.failed;
+    output_flush();
+
+    char buf[24];
+    output_writer->begin();
+    output_append(">: ", 0);
+    output_append(buf, snprintf(buf, sizeof(buf), "%u: ", (unsigned int)line));
+    output_append(input.p, input.n);
+    output_append("\n", 0);
+    format_result(vals, output_append);
+    output_writer->end();
+
+    script_state.line_begin = esp_timer_get_time();
+}
+
+static void script_report(const char *fname, int64_t elapsed, bool interrupted)
+{
+    char buf[160];
+
+    if (output_writer == NULL)
+        return;
+
+    output_flush();
+
+    output_writer->begin();
+    output_append(buf, snprintf(buf, sizeof(buf), "<: %s: %u lines, %u failed%s\n   total %u ms, sd read %u ms\n",
+                                fname, (unsigned int)script_state.lines, (unsigned int)script_state.failed,
+                                interrupted ? ", interrupted" : "",
+                                (unsigned int)(elapsed / 1000), (unsigned int)(script_state.read_time / 1000)));
+    if (script_state.lines > 0)
+    {
+        output_append(buf, snprintf(buf, sizeof(buf), "   avg %u us, slowest line %u: %u us\n",
+                                    (unsigned int)(script_state.calc_time / script_state.lines),
+                                    (unsigned int)script_state.max_line, (unsigned int)script_state.max_time));
+    }
+    output_writer->end();
+}
+
+static void script_error(const char *fname, const char *msg)
+{
+    if (output_writer == NULL)
+        return;
+
+    output_writer->begin();
+    output_append("<: error: ", 0);
+    output_append(fname, 0);
+    output_append(": ", 0);
+    output_append(msg, 0);
+    output_append("\n", 0);
+    output_writer->end();
+}
+
+static void script_set_progress(int progress)
+{
+    if (progress == script_progress)
+        return;
+
+    script_progress = progress;
+    if (script_state.callback != NULL)
+        script_state.callback(script_state.ticket, CALC_EVENT_PROGRESS, NULL);
+}
+
+static void calc_script(const char *name, calc_ticket_t ticket, calc_callback_t callback)
+{
+    char fname[SDCARD_MAX_FILE_NAME+1];
+    hexowl_calculate_batch_return_t ret = {0};
+    char *buf = NULL;
+    int64_t begin_time;
+    sdcard_file_t f;
+    int64_t offset = 0;
+    int fill = 0;
+    int64_t size;
+    int len;
+
+    if (strchr(name, '.') == NULL)
+        len = snprintf(fname, sizeof(fname), "%s" SCRIPT_EXT, name);
     else
+        len = snprintf(fname, sizeof(fname), "%s", name);
+
+    if (len < 0 || len >= (int)sizeof(fname))
+    {
+        script_error(name, "too long file name");
+        return;
+    }
+
+    if (!sdcard_is_mounted() && sdcard_mount() != SD_OK)
+    {
+        script_error(fname, "SD card mount failure");
+        return;
+    }
+
+    size = sdcard_file_size_raw(fname);
+    if (size < 0)
+    {
+        script_error(fname, "file not exists");
+        return;
+    }
+
+    buf = heap_caps_malloc(SCRIPT_CHUNK_LEN, MALLOC_CAP_SPIRAM);
+    if (buf == NULL)
+    {
+        script_error(fname, "out of memory");
+        return;
+    }
+
+    script_state = (calc_script_state_t){.ticket = ticket, .callback = callback};
+    begin_time = esp_timer_get_time();
+    script_set_progress(0);
+
+    while (1)
     {
-        if (vals.decVal.n > 0)
+        int64_t read_begin = esp_timer_get_time();
+        int n = -1;
+        int end;
+        bool eof;
+
+        // the file is not kept open between the chunks,
+        // so the script itself is free to save and load files
+        if (sdcard_file_open(&f, fname, "r") == SD_OK)
         {
-            strend = str_chain_append(strend, "<: ", 0);
-            strend = str_chain_append(strend, vals.decVal.p, vals.decVal.n);
+            if (sdcard_file_seek(f, offset + fill) == SD_OK)
+                n = sdcard_file_read(f, &buf[fill], SCRIPT_CHUNK_LEN - fill);
+            sdcard_file_close(f);
         }
-        if (vals.hexVal.n > 0)
+        script_state.read_time += esp_timer_get_time() - read_begin;
+
+        if (n < 0)
         {
-            strend = str_chain_append(strend, "\n   ", 0);
-            strend = str_chain_append(strend, vals.hexVal.p, vals.hexVal.n);
+            script_error(fname, "read failure");
+            break;
         }
-        if (vals.binVal.n > 0)
+
+        fill += n;
+        eof = n == 0 || offset + fill >= size;
+
+        // evaluate only the complete lines, the tail waits for the next chunk
+        end = fill;
+        if (!eof)
         {
-            strend = str_chain_append(strend, "\n   ", 0);
-            strend = str_chain_append(strend, vals.binVal.p, vals.binVal.n);
+            while (end > 0 && buf[end - 1] != '\n')
+                --end;
+            if (end == 0)
+            {
+                script_error(fname, "too long line");
+                break;
+            }
         }
 
-        // strend = str_chain_append(strend, "\r\n\r\n\tTime:\t", 0);
-        // itoa(vals.calcTime, strend, 10);
-        // strend += strlen(strend);
-        // strend = str_chain_append(strend, " ms\r\n\r\n", 0);
+        script_state.line_begin = esp_timer_get_time();
+        ret = HexowlCalculateBatch((GoString){buf, end}, script_result);
+        ++env_epoch;
+
+        for (int i = 0; i < end; ++i)
+        {
+            if (buf[i] == '\n')
+                ++script_state.line_base;
+        }
+
+        offset += end;
+        fill -= end;
+        memmove(buf, &buf[end], fill);
+
+        script_set_progress(size > 0 ? (int)(offset * 100 / size) : 100);
+
+        if (ret.interrupted || eof)
+            break;
+    }
+
+    heap_caps_free(buf);
+    script_report(fname, esp_timer_get_time() - begin_time, ret.interrupted);
+    script_progress = -1;
+}
+
+static bool commit_preview(const char *input, int len)
+{
+    // a preview has no side effects, so while nothing was calculated
+    // after it, its result is exactly what the calculation would give
+    if (!preview_res.valid || preview_res.epoch != env_epoch)
+        return false;
+    if (preview_res.len != len || memcmp(preview_res.input, input, len) != 0)
+        return false;
+
+    if (output_writer != NULL)
+    {
+        output_writer->begin();
+        output_append(preview_res.result, preview_res.result_len);
+        output_writer->end();
+    }
+
+    return true;
+}
+
+// ticks left until the pending preview is due, 0 once it is
+static TickType_t preview_time_left(void)
+{
+    TickType_t left = preview_req.due - xTaskGetTickCount();
+    return left > PREVIEW_DELAY ? 0 : left;
+}
+
+static TickType_t preview_wait_time(TickType_t idle_wait)
+{
+    TickType_t wait = idle_wait;
+
+    xSemaphoreTake(preview_lock, portMAX_DELAY);
+    if (preview_req.pending)
+        wait = preview_time_left();
+    xSemaphoreGive(preview_lock);
+
+    return wait;
+}
+
+// an interrupt of the previous request must not stop the next one,
+// while all the calculations of one request, a script or a batch, see it
+static void begin_request(void)
+{
+    HexowlBeginRequest();
+    native_reset();
+}
+
+static bool run_preview(void)
+{
+    hexowl_calculate_return_t vals;
+    calc_preview_callback_t callback;
+    uint32_t generation;
+    bool stale;
+
+    xSemaphoreTake(preview_lock, portMAX_DELAY);
+    if (!preview_req.pending || preview_time_left() > 0)
+    {
+        xSemaphoreGive(preview_lock);
+        return false;
+    }
+    preview_res.len = preview_req.len;
+    memcpy(preview_res.input, preview_req.input, preview_req.len + 1);
+    generation = preview_req.generation;
+    callback = preview_req.callback;
+    preview_req.pending = false;
+    xSemaphoreGive(preview_lock);
+
+    preview_res.valid = false;
+    if (preview_res.len == 0)
+    {
+        if (callback != NULL)
+            callback(NULL);
+        return true;
+    }
+
+    if (!fast_calculate(preview_res.input, preview_res.len, &vals))
+    {
+        begin_request();
+        preview_running = true;
+        esp_pm_lock_acquire(pm_lock);
+        vals = HexowlPreview((GoString){preview_res.input, preview_res.len});
+        esp_pm_lock_release(pm_lock);
+        preview_running = false;
+    }
+
+    // the text was edited again while it was evaluated
+    xSemaphoreTake(preview_lock, portMAX_DELAY);
+    stale = generation != preview_req.generation;
+    xSemaphoreGive(preview_lock);
+    if (stale)
+        return true;
+
+    preview_res.result_len = 0;
+    format_result(&vals, preview_append);
+    preview_res.epoch = env_epoch;
+    preview_res.valid = vals.success && !vals.interrupted;
+
+    if (callback != NULL)
+        callback(preview_res.valid ? preview_res.result : NULL);
+
+    return true;
+}
+
+static uint32_t load_heap_peak(void)
+{
+    nvs_handle_t nvs;
+    uint32_t peak = 0;
+
+    if (nvs_open("calc", NVS_READONLY, &nvs) != ESP_OK)
+        return 0;
+
+    nvs_get_u32(nvs, "heap_peak", &peak);
+    nvs_close(nvs);
+    return peak;
+}
+
+static void save_heap_peak(uint32_t peak)
+{
+    nvs_handle_t nvs;
+
+    if (nvs_open("calc", NVS_READWRITE, &nvs) != ESP_OK)
+    {
+        ESP_LOGW("calc", "unable to open nvs");
+        return;
+    }
+
+    if (nvs_set_u32(nvs, "heap_peak", peak) == ESP_OK)
+        nvs_commit(nvs);
+    nvs_close(nvs);
+}
+
+static void track_heap_peak(void)
+{
+    hexowl_stats_t stats;
+
+    HexowlStats(&stats);
+    if (stats.heapInuse > heap_peak)
+        heap_peak = stats.heapInuse;
+
+    // the heap can not grow during the session: a nearly full heap is
+    // recorded as bigger than it is, so the next boot gives more room
+    if (stats.heapInuse > heap_size / 10 * 9 && heap_peak < heap_size)
+        heap_peak = heap_size;
+
+    // save rarely to spare the flash
+    if (heap_peak > heap_peak_saved + HEAP_PEAK_SAVE_STEP)
+    {
+        save_heap_peak(heap_peak);
+        heap_peak_saved = heap_peak;
+        ESP_LOGI("calc", "new heap peak: %u", (unsigned int)heap_peak);
     }
-    
-    strend = str_chain_append(strend, "\n", 0);
+}
+
+bool calc_plan_memory(calc_args_t *args)
+{
+    size_t psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    size_t budget = psram_free > PSRAM_RESERVE ? psram_free - PSRAM_RESERVE : 0;
+    size_t stack = budget / 4;
+    size_t heap;
+
+    if (budget < STACK_MIN_SIZE + HEAP_MIN_SIZE)
+    {
+        ESP_LOGE("calc", "psram free: %u, too little for the heap and the stack", psram_free);
+        return false;
+    }
+
+    heap_peak_saved = load_heap_peak();
+    heap_peak = heap_peak_saved;
+
+    if (stack < STACK_MIN_SIZE)
+        stack = STACK_MIN_SIZE;
+    else if (stack > STACK_MAX_SIZE)
+        stack = STACK_MAX_SIZE;
+
+    // the stack is at most a quarter of the budget or its minimum,
+    // so what is left is never less than the minimal heap
+    heap = (size_t)heap_peak * HEAP_PEAK_HEADROOM / 100;
+    if (heap < HEAP_MIN_SIZE)
+        heap = HEAP_MIN_SIZE;
+    if (heap > HEAP_MAX_SIZE)
+        heap = HEAP_MAX_SIZE;
+    if (heap > budget - stack)
+        heap = budget - stack;
+
+    args->heap_size = heap;
+    args->stack_size = stack;
+
+    ESP_LOGI("calc", "psram free: %u, heap peak: %u, heap: %u, stack: %u",
+        psram_free, (unsigned int)heap_peak, heap, stack);
+
+    return true;
 }
 
 void calc_task(void *arg)
 {
     calc_args_t *props = (calc_args_t *)arg;
 
-    calc_begin_sem = xSemaphoreCreateBinary();
-    calc_in_lock_mux = xSemaphoreCreateMutex();
+    uint8_t req_id;
+    bool gc_pending = false;
+    uint32_t gc_pause;
+
+    // one more place for the preview wake up
+    calc_request_queue = xQueueCreate(CALC_QUEUE_DEPTH + 1, sizeof(uint8_t));
+    calc_free_queue = xQueueCreate(CALC_QUEUE_DEPTH, sizeof(uint8_t));
     calc_out_sem = xSemaphoreCreateBinary();
-    calc_out_done_sem = xSemaphoreCreateBinary();
-    calc_done_sem = xSemaphoreCreateBinary();
+    calc_out_space_sem = xSemaphoreCreateBinary();
+    preview_lock = xSemaphoreCreateMutex();
 
-    if (calc_begin_sem == NULL || calc_in_lock_mux == NULL || calc_out_sem == NULL || calc_out_done_sem == NULL || calc_done_sem == NULL)
+    if (calc_request_queue == NULL || calc_free_queue == NULL || calc_out_sem == NULL || calc_out_space_sem == NULL || preview_lock == NULL)
     {
-        ESP_LOGE("calc", "semaphore creation error");
+        ESP_LOGE("calc", "queue creation error");
+        goto error;
+    }
+
+    output_ring = ring_init(OUTPUT_RING_LEN);
+    if (output_ring == NULL)
+    {
+        ESP_LOGE("calc", "output ring allocation error");
+        goto error;
+    }
+
+    perf = perf_init(PERF_PHASES_COUNT, PERF_SAMPLES);
+    if (perf == NULL)
+    {
+        ESP_LOGE("calc", "perf samples allocation error");
         goto error;
     }
 
@@ -201,8 +929,7 @@ void calc_task(void *arg)
         goto error;
     }
 
-    xSemaphoreGive(calc_out_done_sem);
-
+    heap_size = props->heap_size;
     uintptr_t go_heap_size = (uintptr_t)props->heap_size;
     gorun(go_heap_size);
 
@@ -217,19 +944,113 @@ void calc_task(void *arg)
         hx_fwrite_func,
         hx_fread_func);
 
+    HexowlSetPerfFunc(hx_perf_func);
+    native_register();
+    if (props->register_builtins != NULL)
+        props->register_builtins();
+
+    // typing boosts the CPU, so an evaluation starts at the full speed
+    if (!governor_init(FREQ_MIN, FREQ_HIGH, BOOST_DECAY))
+        goto error;
+    keyboard_register_activity_callback(governor_boost);
+
+    // the slots are in the Go heap, so a cached tree can keep its input without a copy
+    for (req_id = 0; req_id < CALC_QUEUE_DEPTH; ++req_id)
+    {
+        requests[req_id].input = HexowlInputBuffer(NULL, INPUT_LEN + 1);
+        xQueueSend(calc_free_queue, &req_id, 0);
+    }
+
     ESP_LOGI("calc", "hexowl task initialized");
-    set_cpu_freq(FREQ_HIGH);
 
     while (1)
     {
-        if (xSemaphoreTake(calc_begin_sem, portMAX_DELAY))
+        if (xQueueReceive(calc_request_queue, &req_id, preview_wait_time(gc_pending ? GC_IDLE_POLL : portMAX_DELAY)))
         {
-            esp_pm_lock_acquire(pm_lock);
-            // calculate expression
-            calc_begin();
+            if (req_id == PREVIEW_WAKE)
+            {
+                xSemaphoreTake(preview_lock, portMAX_DELAY);
+                preview_req.wake_sent = false;
+                xSemaphoreGive(preview_lock);
+                continue;
+            }
+
+            calc_request_t *req = &requests[req_id];
+            bool batch = memchr(req->input, '\n', req->len) != NULL;
+
+            if (req->error != NULL)
+            {
+                calc_reject(req->error);
+                if (req->callback != NULL)
+                {
+                    req->callback(req->ticket, CALC_EVENT_ERROR, req->error);
+                    req->callback(req->ticket, CALC_EVENT_DONE, NULL);
+                }
+                xQueueSend(calc_free_queue, &req_id, 0);
+                continue;
+            }
+
+            begin_request();
+
+            perf_sample = perf_begin(perf);
+            perf_record(perf, perf_sample, PERF_HANDOFF, esp_timer_get_time() - req->submit_time);
+
+            // batch lines are echoed one by one, a script prints its own summary
+            if (!batch && !req->script)
+                calc_echo(req->input, req->len);
+            if (req->callback != NULL)
+                req->callback(req->ticket, CALC_EVENT_BEGIN, req->input);
+
+            if (req->script)
+            {
+                esp_pm_lock_acquire(pm_lock);
+                calc_script(req->input, req->ticket, req->callback);
+                esp_pm_lock_release(pm_lock);
+            }
+            else if (batch)
+            {
+                esp_pm_lock_acquire(pm_lock);
+                calc_batch(req->input, req->len);
+                esp_pm_lock_release(pm_lock);
+            }
+            else if (!commit_preview(req->input, req->len))
+            {
+                esp_pm_lock_acquire(pm_lock);
+                // calculate expression
+                calc_begin(req->input, req->len);
+                esp_pm_lock_release(pm_lock);
+            }
+
+            // keep the speed for the scrolling and editing that follow a result
+            governor_boost();
+
+            // the next frame shows the result
+            __atomic_store_n(&perf_frame_sample, perf_sample + 1, __ATOMIC_RELEASE);
+
             // inform about complete
+            if (req->callback != NULL)
+                req->callback(req->ticket, CALC_EVENT_DONE, NULL);
+
+            req->input = HexowlInputBuffer(req->input, INPUT_LEN + 1);
+            xQueueSend(calc_free_queue, &req_id, 0);
+            gc_pending = true;
+        }
+        else if (run_preview())
+        {
+            gc_pending = true;
+        }
+        else if (gc_pending && keyboard_is_idle())
+        {
+            // collect the garbage of the last calculations while nobody is typing,
+            // so the collector does not have to run in the middle of the next one
+            esp_pm_lock_acquire(pm_lock);
+            track_heap_peak();
+            gc_pause = HexowlCollect(GC_HEAP_THRESHOLD);
             esp_pm_lock_release(pm_lock);
-            xSemaphoreGive(calc_done_sem);
+            gc_pending = false;
+
+            if (gc_pause > 0)
+                ESP_LOGI("calc", "idle gc pause: %u us", (unsigned int)gc_pause);
         }
     }
 
@@ -237,46 +1058,151 @@ error:
     while (1) vTaskDelay(1000);
 }
 
-void calc_expression(const char *expr)
+static calc_ticket_t submit(const char *expr, calc_callback_t clbk, bool script)
 {
-    if (xSemaphoreTake(calc_in_lock_mux, LOCK_TIMEOUT))
+    uint8_t req_id;
+    calc_request_t *req;
+
+    if (calc_free_queue == NULL || !xQueueReceive(calc_free_queue, &req_id, 0))
     {
-        strcpy(input_str, expr);
-        xSemaphoreGive(calc_begin_sem);
+        ESP_LOGW("calc", "request queue is full");
+        return 0;
     }
-    else
+
+    req = &requests[req_id];
+    req->callback = clbk;
+    req->script = script;
+    req->submit_time = esp_timer_get_time();
+    req->ticket = __atomic_add_fetch(&last_ticket, 1, __ATOMIC_RELAXED);
+    if (req->ticket == 0)
+        req->ticket = __atomic_add_fetch(&last_ticket, 1, __ATOMIC_RELAXED);
+
+    req->error = NULL;
+    req->len = strnlen(expr, INPUT_LEN);
+    if (expr[req->len] != '\0')
     {
-        ESP_LOGW("calc", "input resource lock mutex timeout");
+        // a batch over the limit loses its lines from the cut one on, a half
+        // line or script name would be evaluated as a different one, so a
+        // request without a whole line in the limit is rejected
+        int len = req->len + 1;
+        if (expr[req->len] != '\n')
+        {
+            while (len > 0 && expr[len - 1] != '\n')
+                --len;
+        }
+
+        if (len > 0 && !script)
+        {
+            req->len = len - 1;
+            ESP_LOGW("calc", "batch cut to %d of its bytes", req->len);
+        }
+        else
+        {
+            req->len = 0;
+            req->error = "input is longer than 1024 bytes";
+        }
     }
+    memcpy(req->input, expr, req->len);
+    req->input[req->len] = 0;
+
+    xQueueSend(calc_request_queue, &req_id, 0);
+    return req->ticket;
 }
 
-const char *calc_await_expression(void)
+calc_ticket_t calc_submit(const char *expr, calc_callback_t clbk)
 {
-    if (xSemaphoreTake(calc_done_sem, portMAX_DELAY))
-    {
-        xSemaphoreGive(calc_in_lock_mux);
-        return output_str;
-    }
-    else
-    {
-        ESP_LOGE("calc", "expression calculation timeout");
-        return NULL;
-    }
+    return submit(expr, clbk, false);
 }
 
-const char *calc_await_output(int timeout)
+calc_ticket_t calc_run_script(const char *name, calc_callback_t clbk)
 {
-    if (xSemaphoreTake(calc_out_sem, timeout))
-    {
-        return general_output_str;
-    }
-    else
-    {
-        return NULL;
-    }
+    return submit(name, clbk, true);
+}
+
+int calc_script_progress(void)
+{
+    return script_progress;
+}
+
+void calc_perf_frame(uint32_t us, uint32_t bytes, uint32_t coalesced)
+{
+    unsigned int sample = __atomic_exchange_n(&perf_frame_sample, 0, __ATOMIC_ACQUIRE);
+
+    ++perf_frames;
+    perf_frames_coalesced += coalesced;
+    if (us > perf_frame_max_us)
+        perf_frame_max_us = us;
+    perf_frame_bytes += bytes;
+    perf_frame_bytes_last = bytes;
+    if (bytes > perf_frame_bytes_max)
+        perf_frame_bytes_max = bytes;
+
+    if (sample != 0)
+        perf_record(perf, sample - 1, PERF_FRAME, us);
+}
+
+void calc_preview(const char *expr, calc_preview_callback_t clbk)
+{
+    const uint8_t wake = PREVIEW_WAKE;
+    bool wake_up;
+
+    if (preview_lock == NULL)
+        return;
+
+    xSemaphoreTake(preview_lock, portMAX_DELAY);
+    preview_req.len = strnlen(expr, INPUT_LEN);
+    memcpy(preview_req.input, expr, preview_req.len);
+    preview_req.input[preview_req.len] = 0;
+    preview_req.callback = clbk;
+    preview_req.due = xTaskGetTickCount() + PREVIEW_DELAY;
+    preview_req.pending = true;
+    ++preview_req.generation;
+
+    // supersede the evaluation of the previous text
+    if (preview_running)
+        HexowlInterrupt();
+
+    wake_up = !preview_req.wake_sent;
+    preview_req.wake_sent = true;
+    xSemaphoreGive(preview_lock);
+
+    if (wake_up)
+        xQueueSend(calc_request_queue, &wake, 0);
+}
+
+void calc_set_writer(const calc_writer_t *writer)
+{
+    output_writer = writer;
+}
+
+void calc_cancel(void)
+{
+    HexowlInterrupt();
+    native_interrupt();
+}
+
+bool calc_await_output(int timeout)
+{
+    return xSemaphoreTake(calc_out_sem, timeout) == pdTRUE;
+}
+
+int calc_read_output(const char **str)
+{
+    if (output_ring == NULL)
+        return 0;
+
+    return ring_peek(output_ring, str);
+}
+
+void calc_done_output(int len)
+{
+    ring_consume(output_ring, len);
+    xSemaphoreGive(calc_out_space_sem);
 }
 
-void calc_done_output(void)
+void calc_get_output_stats(calc_output_stats_t *stats)
 {
-    xSemaphoreGive(calc_out_done_sem);
+    *stats = output_stats;
+    if (output_ring != NULL)
+        stats->high_water = output_ring->high_water;
 }
@@ -1,14 +1,86 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define CALC_QUEUE_DEPTH (4)
+
+typedef unsigned int calc_ticket_t;
+
+typedef enum {
+    CALC_EVENT_BEGIN,
+    CALC_EVENT_DONE,
+    CALC_EVENT_PROGRESS,
+    CALC_EVENT_ERROR,
+} calc_event_t;
+
+// executed from the calc task: str is the input on begin, the reason on error and NULL
+// on done and progress; a rejected request gets error and done without a begin,
+// the echo, the result and the error itself go to the output writer
+typedef void (*calc_callback_t)(calc_ticket_t ticket, calc_event_t event, const char *str);
+
+// executed from the calc task with the formatted preview result, NULL if there is none
+typedef void (*calc_preview_callback_t)(const char *result);
+
+// output storage the calc task formats into, write is called between begin and end
+typedef struct {
+    void (*begin)(void);
+    void (*write)(const char *str, int len);
+    void (*end)(void);
+} calc_writer_t;
+
 void calc_task(void *arg);
 
-void calc_expression(const char *expr);
-const char *calc_await_expression(void);
+// newline separated expressions are evaluated as one batch with a result per line,
+// returns 0 if the request queue is full; a batch over 1024 bytes is cut at its last
+// whole line within them, so a longer file goes through calc_run_script, and an input
+// without a whole line in them is rejected with an error event; the keyboard types
+// no newline, a batch only comes from a caller that builds one
+calc_ticket_t calc_submit(const char *expr, calc_callback_t clbk);
+// run a script from the SD card environment directory line by line, the name
+// gets the .hxs extension if it has none, only the failed lines and a timing
+// summary are printed, returns 0 if the request queue is full; a name over 1024
+// bytes is rejected with an error event
+calc_ticket_t calc_run_script(const char *name, calc_callback_t clbk);
+// percent of the running script already evaluated, -1 if there is none
+int calc_script_progress(void);
+void calc_set_writer(const calc_writer_t *writer);
+// evaluate the edited text without side effects after a short debounce,
+// submitting the same text later takes the already computed result
+void calc_preview(const char *expr, calc_preview_callback_t clbk);
+// abort the running calculation, its result is reported as interrupted
+void calc_cancel(void);
+
+typedef struct {
+    size_t written;
+    size_t dropped;
+    size_t high_water;
+    unsigned int overruns; // times the printer waited for free space
+} calc_output_stats_t;
+
+// printed output is kept in a ring until the screen drains it:
+// wait for pending data, then read and release contiguous spans
+bool calc_await_output(int timeout);
+int calc_read_output(const char **str);
+void calc_done_output(int len);
+void calc_get_output_stats(calc_output_stats_t *stats);
 
-const char *calc_await_output(int timeout);
-void calc_done_output(void);
+// duration of drawing and queueing a frame, its SPI bytes and the invalidations
+// merged into it; the first duration after a result is kept as the frame phase
+// of the perf builtin
+void calc_perf_frame(uint32_t us, uint32_t bytes, uint32_t coalesced);
 
 typedef struct {
     char *firmware_version;
     unsigned int heap_size;
+    unsigned int stack_size;
+    // registers the builtins of other modules through HexowlRegisterNative,
+    // called from the calc task after hexowl is initialized, may be NULL
+    void (*register_builtins)(void);
 } calc_args_t;
+
+// size the Go heap and the calc task stack from the free PSRAM and
+// the heap peak recorded in the previous sessions, needs initialized NVS,
+// false when the PSRAM can not hold even the minimal heap and stack
+bool calc_plan_memory(calc_args_t *args);
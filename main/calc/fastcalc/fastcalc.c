@@ -0,0 +1,278 @@
+#include "fastcalc.h"
+
+#include <string.h>
+
+#define MAX_TOKENS (64)
+#define MAX_DEPTH (16)
+#define SIGN_BIT (1ULL << 63)
+
+typedef enum {
+    TOK_NUM,
+    TOK_LPAREN,
+    TOK_RPAREN,
+    TOK_NOT,
+    TOK_ADD,
+    TOK_SUB,
+    TOK_MUL,
+    TOK_SHL,
+    TOK_SHR,
+    TOK_AND,
+    TOK_OR,
+    TOK_END,
+    TOK_COUNT,
+} fc_token_type_t;
+
+typedef struct {
+    fc_token_type_t type;
+    uint64_t val;
+} fc_token_t;
+
+typedef struct {
+    const fc_token_t *tok;
+    const unsigned char *prec;
+    int depth;
+} fc_parser_t;
+
+// the operator precedence of hexowl is not pinned down here, so an expression
+// is evaluated with both the C and the Go table and only an agreeing result counts
+static const unsigned char prec_c[TOK_COUNT] = {
+    [TOK_MUL] = 5,
+    [TOK_ADD] = 4, [TOK_SUB] = 4,
+    [TOK_SHL] = 3, [TOK_SHR] = 3,
+    [TOK_AND] = 2,
+    [TOK_OR] = 1,
+};
+
+static const unsigned char prec_go[TOK_COUNT] = {
+    [TOK_MUL] = 2, [TOK_SHL] = 2, [TOK_SHR] = 2, [TOK_AND] = 2,
+    [TOK_ADD] = 1, [TOK_SUB] = 1, [TOK_OR] = 1,
+};
+
+static int digit_value(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return 99;
+}
+
+static bool is_word_char(char c)
+{
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c == '.';
+}
+
+static int tokenize(const char *s, int len, fc_token_t *tok)
+{
+    int n = 0;
+    int i = 0;
+
+    while (i < len)
+    {
+        char c = s[i];
+
+        if (c == ' ' || c == '\t')
+        {
+            ++i;
+            continue;
+        }
+
+        if (n >= MAX_TOKENS - 1)
+            return -1;
+
+        if (c >= '0' && c <= '9')
+        {
+            int base = 10;
+            int begin;
+            uint64_t val = 0;
+
+            if (c == '0' && i + 1 < len && (s[i + 1] == 'x' || s[i + 1] == 'b'))
+            {
+                base = s[i + 1] == 'x' ? 16 : 2;
+                i += 2;
+            }
+            else if (c == '0' && i + 1 < len && s[i + 1] >= '0' && s[i + 1] <= '9')
+            {
+                // leading zeros may mean octal
+                return -1;
+            }
+
+            begin = i;
+            while (i < len && digit_value(s[i]) < base)
+            {
+                int d = digit_value(s[i]);
+                if (val > (UINT64_MAX - d) / base)
+                    return -1;
+                val = val * base + d;
+                ++i;
+            }
+
+            // floats, exponents, suffixes and empty prefixed literals are not ours,
+            // neither are literals that would not fit a signed integer
+            if (i == begin || (i < len && is_word_char(s[i])) || (val & SIGN_BIT))
+                return -1;
+
+            tok[n++] = (fc_token_t){TOK_NUM, val};
+            continue;
+        }
+
+        switch (c)
+        {
+        case '(': tok[n].type = TOK_LPAREN; break;
+        case ')': tok[n].type = TOK_RPAREN; break;
+        case '~': tok[n].type = TOK_NOT; break;
+        case '+': tok[n].type = TOK_ADD; break;
+        case '-': tok[n].type = TOK_SUB; break;
+        case '&': tok[n].type = TOK_AND; break;
+        case '|': tok[n].type = TOK_OR; break;
+        case '*': tok[n].type = TOK_MUL; break;
+        case '<':
+        case '>':
+            if (i + 1 >= len || s[i + 1] != c)
+                return -1;
+            tok[n].type = c == '<' ? TOK_SHL : TOK_SHR;
+            ++i;
+            break;
+        default:
+            return -1;
+        }
+
+        // doubled operators are power, logical or assignment forms
+        if (i + 1 < len && tok[n].type >= TOK_ADD && (s[i + 1] == c || s[i + 1] == '='))
+            return -1;
+
+        ++i;
+        ++n;
+    }
+
+    tok[n++] = (fc_token_t){TOK_END, 0};
+    return n;
+}
+
+// arithmetic is accepted only where signed and unsigned 64-bit values agree,
+// without wrapping and with a clear sign bit, so the literal types do not matter
+static bool apply(fc_token_type_t op, uint64_t a, uint64_t b, uint64_t *res)
+{
+    switch (op)
+    {
+    case TOK_ADD:
+        if ((a | b) & SIGN_BIT) return false;
+        *res = a + b;
+        return (*res & SIGN_BIT) == 0;
+    case TOK_SUB:
+        if (((a | b) & SIGN_BIT) || a < b) return false;
+        *res = a - b;
+        return true;
+    case TOK_MUL:
+        if ((a | b) & SIGN_BIT) return false;
+        if (__builtin_mul_overflow(a, b, res)) return false;
+        return (*res & SIGN_BIT) == 0;
+    case TOK_SHL:
+        if (b >= 64 || (a & SIGN_BIT)) return false;
+        *res = a << b;
+        return (*res >> b) == a && (*res & SIGN_BIT) == 0;
+    case TOK_SHR:
+        if (b >= 64 || (a & SIGN_BIT)) return false;
+        *res = a >> b;
+        return true;
+    case TOK_AND:
+        *res = a & b;
+        return true;
+    case TOK_OR:
+        *res = a | b;
+        return true;
+    default:
+        return false;
+    }
+}
+
+static bool parse_expr(fc_parser_t *p, int min_prec, uint64_t *val);
+
+static bool parse_unary(fc_parser_t *p, uint64_t *val)
+{
+    const fc_token_t *t = p->tok++;
+
+    switch (t->type)
+    {
+    case TOK_NUM:
+        *val = t->val;
+        return true;
+    case TOK_NOT:
+        if (!parse_unary(p, val))
+            return false;
+        *val = ~*val;
+        return true;
+    case TOK_LPAREN:
+        if (++p->depth > MAX_DEPTH)
+            return false;
+        if (!parse_expr(p, 1, val) || p->tok->type != TOK_RPAREN)
+            return false;
+        --p->depth;
+        ++p->tok;
+        return true;
+    default:
+        // unary minus and plus included, their result type is not ours to guess
+        return false;
+    }
+}
+
+static bool parse_expr(fc_parser_t *p, int min_prec, uint64_t *val)
+{
+    if (!parse_unary(p, val))
+        return false;
+
+    while (1)
+    {
+        fc_token_type_t op = p->tok->type;
+        int prec = p->prec[op];
+        uint64_t rhs;
+
+        if (op == TOK_END || op == TOK_RPAREN)
+            return true;
+        if (prec == 0)
+            return false;
+        if (prec < min_prec)
+            return true;
+
+        ++p->tok;
+        // left associative
+        if (!parse_expr(p, prec + 1, &rhs))
+            return false;
+        if (!apply(op, *val, rhs, val))
+            return false;
+    }
+}
+
+static bool evaluate(const fc_token_t *tok, const unsigned char *prec, uint64_t *val)
+{
+    fc_parser_t p = {
+        .tok = tok,
+        .prec = prec,
+        .depth = 0,
+    };
+
+    if (!parse_expr(&p, 1, val))
+        return false;
+
+    return p.tok->type == TOK_END;
+}
+
+bool fastcalc_eval(const char *expr, int len, uint64_t *result)
+{
+    fc_token_t tok[MAX_TOKENS];
+    uint64_t val_c, val_go;
+    int n;
+
+    n = tokenize(expr, len, tok);
+    if (n <= 1)
+        return false;
+
+    if (!evaluate(tok, prec_c, &val_c) || !evaluate(tok, prec_go, &val_go))
+        return false;
+
+    // a set sign bit would print as negative if the literals are signed
+    if (val_c != val_go || (val_c & SIGN_BIT))
+        return false;
+
+    *result = val_c;
+    return true;
+}
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// evaluate a plain integer expression of literals without the Go runtime:
+// decimal, 0x and 0b literals, parentheses, ~ and the binary + - * << >> & |;
+// returns false for anything it can not prove to give the same result as
+// hexowl, the caller falls back to HexowlCalculate then
+bool fastcalc_eval(const char *expr, int len, uint64_t *result);
@@ -0,0 +1,143 @@
+#include "numfmt.h"
+
+#include <string.h>
+
+static const char hex_digits[16] = "0123456789ABCDEF";
+
+static const char bin_nibbles[16][4] = {
+    "0000", "0001", "0010", "0011", "0100", "0101", "0110", "0111",
+    "1000", "1001", "1010", "1011", "1100", "1101", "1110", "1111",
+};
+
+static const char dec_pairs[200] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+// count of significant nibbles, at least one
+static int nibbles_count(uint64_t val)
+{
+    int n = 16;
+
+    if (val == 0)
+        return 1;
+
+    while ((val >> 60) == 0)
+    {
+        val <<= 4;
+        --n;
+    }
+
+    return n;
+}
+
+int numfmt_udec(char *buf, uint64_t val)
+{
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+    int len;
+
+    // two digits per division
+    while (val >= 100)
+    {
+        unsigned int pair = val % 100;
+        val /= 100;
+        p -= 2;
+        memcpy(p, &dec_pairs[pair * 2], 2);
+    }
+
+    if (val >= 10)
+    {
+        p -= 2;
+        memcpy(p, &dec_pairs[val * 2], 2);
+    }
+    else
+    {
+        *--p = '0' + val;
+    }
+
+    len = tmp + sizeof(tmp) - p;
+    memcpy(buf, p, len);
+    buf[len] = '\0';
+    return len;
+}
+
+int numfmt_dec(char *buf, int64_t val)
+{
+    if (val >= 0)
+        return numfmt_udec(buf, val);
+
+    buf[0] = '-';
+    return 1 + numfmt_udec(buf + 1, -(uint64_t)val);
+}
+
+int numfmt_hex(char *buf, uint64_t val)
+{
+    int n = nibbles_count(val);
+    char *p = buf;
+
+    *p++ = '0';
+    *p++ = 'x';
+    for (int i = n - 1; i >= 0; --i)
+        *p++ = hex_digits[(val >> (i * 4)) & 0xF];
+
+    *p = '\0';
+    return p - buf;
+}
+
+int numfmt_bin(char *buf, uint64_t val, int group)
+{
+    int n = nibbles_count(val);
+    const char *first;
+    int skip = 0;
+    int digits;
+    char *p = buf;
+
+    *p++ = '0';
+    *p++ = 'b';
+
+    // leading zeros of the first nibble
+    first = bin_nibbles[(val >> ((n - 1) * 4)) & 0xF];
+    while (skip < 3 && first[skip] == '0')
+        ++skip;
+
+    digits = n * 4 - skip;
+    for (int i = n - 1; i >= 0; --i)
+    {
+        const char *nib = bin_nibbles[(val >> (i * 4)) & 0xF];
+        int from = (i == n - 1) ? skip : 0;
+
+        for (int b = from; b < 4; ++b)
+        {
+            *p++ = nib[b];
+            --digits;
+            if (group > 0 && digits > 0 && digits % group == 0)
+                *p++ = '_';
+        }
+    }
+
+    *p = '\0';
+    return p - buf;
+}
+
+uint64_t numfmt_float_int(double val)
+{
+    // the bounds are exact powers of two, a cast outside of them is undefined
+    if (val != val)
+        return 0;
+    if (val >= 18446744073709551616.0)
+        return UINT64_MAX;
+    if (val < -9223372036854775808.0)
+        return (uint64_t)INT64_MIN;
+    if (val < 0)
+        return (uint64_t)(int64_t)val;
+
+    return (uint64_t)val;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stdint.h>
+
+// longest output: "0b" + 64 digits + 15 group separators + '\0'
+#define NUMFMT_MAX_LEN (82)
+
+// every function writes a null terminated string and returns its length
+
+int numfmt_udec(char *buf, uint64_t val);
+int numfmt_dec(char *buf, int64_t val);
+int numfmt_hex(char *buf, uint64_t val);
+// group is the count of digits between '_' separators: 0, 4 or 8
+int numfmt_bin(char *buf, uint64_t val, int group);
+// shortest digits that read back to the same value, laid out as %v of Go
+int numfmt_float(char *buf, double val);
+// integer bits shown for a float result: truncated toward zero, negatives as
+// two's complement, NaN as zero and out of range values saturated
+uint64_t numfmt_float_int(double val);
@@ -0,0 +1,364 @@
+// shortest round-trip double formatting after Ulf Adams' Ryu,
+// https://github.com/ulfjack/ryu, with the 64-bit multiplications
+// split in 32-bit halves since Xtensa has no 128-bit integers
+
+#include "numfmt.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "ryu_table.h"
+
+#define MANTISSA_BITS (52)
+#define EXPONENT_BITS (11)
+#define EXPONENT_BIAS (1023)
+#define POW5_INV_BITCOUNT (125)
+#define POW5_BITCOUNT (125)
+
+static inline uint64_t umul128(uint64_t a, uint64_t b, uint64_t *high)
+{
+    uint32_t a_lo = (uint32_t)a;
+    uint32_t a_hi = (uint32_t)(a >> 32);
+    uint32_t b_lo = (uint32_t)b;
+    uint32_t b_hi = (uint32_t)(b >> 32);
+
+    uint64_t b00 = (uint64_t)a_lo * b_lo;
+    uint64_t b01 = (uint64_t)a_lo * b_hi;
+    uint64_t b10 = (uint64_t)a_hi * b_lo;
+    uint64_t b11 = (uint64_t)a_hi * b_hi;
+
+    uint64_t mid1 = b10 + (b00 >> 32);
+    uint64_t mid2 = b01 + (uint32_t)mid1;
+
+    *high = b11 + (mid1 >> 32) + (mid2 >> 32);
+    return (mid2 << 32) | (uint32_t)b00;
+}
+
+static inline uint64_t umulh(uint64_t a, uint64_t b)
+{
+    uint64_t high;
+    umul128(a, b, &high);
+    return high;
+}
+
+// the divisions by constants go through multiplications,
+// 64-bit division is a slow library call on 32-bit targets
+static inline uint64_t div5(uint64_t x)
+{
+    return umulh(x, 0xCCCCCCCCCCCCCCCDULL) >> 2;
+}
+
+static inline uint64_t div10(uint64_t x)
+{
+    return umulh(x, 0xCCCCCCCCCCCCCCCDULL) >> 3;
+}
+
+static inline uint64_t div100(uint64_t x)
+{
+    return umulh(x >> 2, 0x28F5C28F5C28F5C3ULL) >> 2;
+}
+
+static inline uint32_t pow5_factor(uint64_t value)
+{
+    uint32_t count = 0;
+
+    for (;;)
+    {
+        uint64_t q = div5(value);
+        if ((uint32_t)value - 5 * (uint32_t)q != 0)
+            break;
+        value = q;
+        ++count;
+    }
+
+    return count;
+}
+
+static inline bool multiple_of_pow5(uint64_t value, uint32_t p)
+{
+    return pow5_factor(value) >= p;
+}
+
+static inline bool multiple_of_pow2(uint64_t value, uint32_t p)
+{
+    return (value & ((1ULL << p) - 1)) == 0;
+}
+
+// ceil(log2(5^e)), 1 for e == 0
+static inline int32_t pow5_bits(int32_t e)
+{
+    return (int32_t)(((uint32_t)e * 1217359) >> 19) + 1;
+}
+
+// floor(log10(2^e))
+static inline uint32_t log10_pow2(int32_t e)
+{
+    return ((uint32_t)e * 78913) >> 18;
+}
+
+// floor(log10(5^e))
+static inline uint32_t log10_pow5(int32_t e)
+{
+    return ((uint32_t)e * 732923) >> 20;
+}
+
+static inline uint64_t mul_shift(uint64_t m, const uint64_t *mul, int32_t j)
+{
+    uint64_t high0, high1, low1, sum;
+    int32_t dist = j - 64;
+
+    umul128(m, mul[0], &high0);
+    low1 = umul128(m, mul[1], &high1);
+    sum = high0 + low1;
+    if (sum < high0)
+        ++high1;
+
+    return (high1 << (64 - dist)) | (sum >> dist);
+}
+
+// decimal mantissa and exponent of the shortest representation inside the rounding interval
+static void shortest_decimal(uint64_t ieee_mantissa, uint32_t ieee_exponent, uint64_t *mantissa, int32_t *exponent)
+{
+    int32_t e2;
+    uint64_t m2;
+    int32_t e10;
+    uint64_t vr, vp, vm;
+    bool vm_trailing_zeros = false;
+    bool vr_trailing_zeros = false;
+    int32_t removed = 0;
+    uint8_t last_removed = 0;
+
+    if (ieee_exponent == 0)
+    {
+        e2 = 1 - EXPONENT_BIAS - MANTISSA_BITS - 2;
+        m2 = ieee_mantissa;
+    }
+    else
+    {
+        e2 = (int32_t)ieee_exponent - EXPONENT_BIAS - MANTISSA_BITS - 2;
+        m2 = (1ULL << MANTISSA_BITS) | ieee_mantissa;
+    }
+
+    // the halfway points are valid representations only for the even mantissas
+    bool accept_bounds = (m2 & 1) == 0;
+    uint64_t mv = 4 * m2;
+    // the lower neighbour is closer at the powers of two
+    uint32_t mm_shift = ieee_mantissa != 0 || ieee_exponent <= 1;
+
+    if (e2 >= 0)
+    {
+        uint32_t q = log10_pow2(e2) - (e2 > 3);
+        int32_t k = POW5_INV_BITCOUNT + pow5_bits(q) - 1;
+        int32_t i = -e2 + (int32_t)q + k;
+
+        e10 = q;
+        vr = mul_shift(4 * m2, pow5_inv_split[q], i);
+        vp = mul_shift(4 * m2 + 2, pow5_inv_split[q], i);
+        vm = mul_shift(4 * m2 - 1 - mm_shift, pow5_inv_split[q], i);
+
+        if (q <= 21)
+        {
+            if ((uint32_t)mv - 5 * (uint32_t)div5(mv) == 0)
+                vr_trailing_zeros = multiple_of_pow5(mv, q);
+            else if (accept_bounds)
+                vm_trailing_zeros = multiple_of_pow5(mv - 1 - mm_shift, q);
+            else
+                vp -= multiple_of_pow5(mv + 2, q);
+        }
+    }
+    else
+    {
+        uint32_t q = log10_pow5(-e2) - (-e2 > 1);
+        int32_t i = -e2 - (int32_t)q;
+        int32_t k = pow5_bits(i) - POW5_BITCOUNT;
+        int32_t j = (int32_t)q - k;
+
+        e10 = (int32_t)q + e2;
+        vr = mul_shift(4 * m2, pow5_split[i], j);
+        vp = mul_shift(4 * m2 + 2, pow5_split[i], j);
+        vm = mul_shift(4 * m2 - 1 - mm_shift, pow5_split[i], j);
+
+        if (q <= 1)
+        {
+            vr_trailing_zeros = true;
+            if (accept_bounds)
+                vm_trailing_zeros = mm_shift == 1;
+            else
+                --vp;
+        }
+        else if (q < 63)
+        {
+            vr_trailing_zeros = multiple_of_pow2(mv, q);
+        }
+    }
+
+    if (vm_trailing_zeros || vr_trailing_zeros)
+    {
+        // rare general case, the exact value may sit on a bound or a halfway point
+        for (;;)
+        {
+            uint64_t vp_div10 = div10(vp);
+            uint64_t vm_div10 = div10(vm);
+            if (vp_div10 <= vm_div10)
+                break;
+
+            uint64_t vr_div10 = div10(vr);
+            vm_trailing_zeros &= (uint32_t)vm - 10 * (uint32_t)vm_div10 == 0;
+            vr_trailing_zeros &= last_removed == 0;
+            last_removed = (uint32_t)vr - 10 * (uint32_t)vr_div10;
+            vr = vr_div10;
+            vp = vp_div10;
+            vm = vm_div10;
+            ++removed;
+        }
+
+        if (vm_trailing_zeros)
+        {
+            for (;;)
+            {
+                uint64_t vm_div10 = div10(vm);
+                if ((uint32_t)vm - 10 * (uint32_t)vm_div10 != 0)
+                    break;
+
+                uint64_t vr_div10 = div10(vr);
+                vr_trailing_zeros &= last_removed == 0;
+                last_removed = (uint32_t)vr - 10 * (uint32_t)vr_div10;
+                vr = vr_div10;
+                vp = div10(vp);
+                vm = vm_div10;
+                ++removed;
+            }
+        }
+
+        // round half to even
+        if (vr_trailing_zeros && last_removed == 5 && vr % 2 == 0)
+            last_removed = 4;
+
+        *mantissa = vr + ((vr == vm && (!accept_bounds || !vm_trailing_zeros)) || last_removed >= 5);
+    }
+    else
+    {
+        bool round_up = false;
+        uint64_t vp_div100 = div100(vp);
+        uint64_t vm_div100 = div100(vm);
+
+        // two digits at a time first
+        if (vp_div100 > vm_div100)
+        {
+            uint64_t vr_div100 = div100(vr);
+            round_up = (uint32_t)vr - 100 * (uint32_t)vr_div100 >= 50;
+            vr = vr_div100;
+            vp = vp_div100;
+            vm = vm_div100;
+            removed += 2;
+        }
+
+        for (;;)
+        {
+            uint64_t vp_div10 = div10(vp);
+            uint64_t vm_div10 = div10(vm);
+            if (vp_div10 <= vm_div10)
+                break;
+
+            uint64_t vr_div10 = div10(vr);
+            round_up = (uint32_t)vr - 10 * (uint32_t)vr_div10 >= 5;
+            vr = vr_div10;
+            vp = vp_div10;
+            vm = vm_div10;
+            ++removed;
+        }
+
+        *mantissa = vr + (vr == vm || round_up);
+    }
+
+    *exponent = e10 + removed;
+}
+
+int numfmt_float(char *buf, double val)
+{
+    uint64_t bits;
+    uint64_t ieee_mantissa;
+    uint32_t ieee_exponent;
+    uint64_t mantissa;
+    int32_t exponent;
+    char digits[20];
+    int nd, dp, x;
+    char *p = buf;
+
+    memcpy(&bits, &val, sizeof(bits));
+    ieee_mantissa = bits & ((1ULL << MANTISSA_BITS) - 1);
+    ieee_exponent = (bits >> MANTISSA_BITS) & ((1u << EXPONENT_BITS) - 1);
+
+    if (ieee_exponent == (1u << EXPONENT_BITS) - 1)
+    {
+        if (ieee_mantissa != 0)
+            strcpy(buf, "NaN");
+        else
+            strcpy(buf, (bits >> 63) ? "-Inf" : "+Inf");
+        return strlen(buf);
+    }
+
+    if (bits >> 63)
+        *p++ = '-';
+
+    if (ieee_exponent == 0 && ieee_mantissa == 0)
+    {
+        *p++ = '0';
+        *p = '\0';
+        return p - buf;
+    }
+
+    shortest_decimal(ieee_mantissa, ieee_exponent, &mantissa, &exponent);
+    nd = numfmt_udec(digits, mantissa);
+    dp = exponent + nd;
+    x = dp - 1;
+
+    // the same layout as %v of Go: %e for exponents below -4 or from 6 on
+    if (x < -4 || x >= 6)
+    {
+        *p++ = digits[0];
+        if (nd > 1)
+        {
+            *p++ = '.';
+            memcpy(p, digits + 1, nd - 1);
+            p += nd - 1;
+        }
+
+        *p++ = 'e';
+        *p++ = (x < 0) ? '-' : '+';
+        if (x < 0)
+            x = -x;
+        if (x < 10)
+            *p++ = '0';
+        p += numfmt_udec(p, x);
+        return p - buf;
+    }
+
+    if (dp <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        memset(p, '0', -dp);
+        p += -dp;
+        memcpy(p, digits, nd);
+        p += nd;
+    }
+    else if (dp >= nd)
+    {
+        memcpy(p, digits, nd);
+        p += nd;
+        memset(p, '0', dp - nd);
+        p += dp - nd;
+    }
+    else
+    {
+        memcpy(p, digits, dp);
+        p += dp;
+        *p++ = '.';
+        memcpy(p, digits + dp, nd - dp);
+        p += nd - dp;
+    }
+
+    *p = '\0';
+    return p - buf;
+}
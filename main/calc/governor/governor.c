@@ -0,0 +1,143 @@
+#include "governor.h"
+
+#include <esp_pm.h>
+#include <esp_log.h>
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// retry of a decay that found the lock taken, the timer task must not block
+#define DECAY_RETRY_US (1000)
+
+static esp_pm_config_t pm_config = {
+    .light_sleep_enable = true,
+};
+
+static esp_pm_lock_handle_t boost_lock;
+static esp_timer_handle_t decay_timer;
+static SemaphoreHandle_t governor_lock = NULL;
+
+static uint32_t decay_time;
+static bool boosted = false;
+static int64_t boost_deadline;
+static int64_t boost_begin;
+static int64_t boost_total = 0;
+static int64_t init_time;
+static unsigned int boost_count = 0;
+
+static void decay_callback(void *arg)
+{
+    // a boost holding the lock restarts the timer anyway, a stats reader
+    // does not, so the decay is tried again shortly
+    if (!xSemaphoreTake(governor_lock, 0))
+    {
+        esp_timer_start_once(decay_timer, DECAY_RETRY_US);
+        return;
+    }
+
+    // the boost may have been renewed while this callback was dispatched
+    if (boosted && esp_timer_get_time() >= boost_deadline)
+    {
+        esp_pm_lock_release(boost_lock);
+        boosted = false;
+        boost_total += esp_timer_get_time() - boost_begin;
+    }
+    xSemaphoreGive(governor_lock);
+}
+
+bool governor_init(uint32_t min_mhz, uint32_t max_mhz, uint32_t decay_ms)
+{
+    const esp_timer_create_args_t timer_args = {
+        .callback = decay_callback,
+        .name = "boost",
+    };
+
+    pm_config.min_freq_mhz = min_mhz;
+    pm_config.max_freq_mhz = max_mhz;
+    decay_time = decay_ms;
+
+    if (esp_pm_configure(&pm_config) != ESP_OK)
+    {
+        ESP_LOGE("gov", "pm configuration error");
+        goto error;
+    }
+
+    if (esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "boost", &boost_lock) != ESP_OK)
+    {
+        ESP_LOGE("gov", "pm lock creation error");
+        goto error;
+    }
+
+    if (esp_timer_create(&timer_args, &decay_timer) != ESP_OK)
+    {
+        ESP_LOGE("gov", "timer creation error");
+        goto error;
+    }
+
+    governor_lock = xSemaphoreCreateMutex();
+    if (governor_lock == NULL)
+    {
+        ESP_LOGE("gov", "mutex creation error");
+        goto error;
+    }
+
+    init_time = esp_timer_get_time();
+    return true;
+
+error:
+    return false;
+}
+
+void governor_set_decay(uint32_t decay_ms)
+{
+    __atomic_store_n(&decay_time, decay_ms, __ATOMIC_RELAXED);
+}
+
+uint32_t governor_get_decay(void)
+{
+    return __atomic_load_n(&decay_time, __ATOMIC_RELAXED);
+}
+
+void governor_boost(void)
+{
+    int64_t now, decay_us;
+
+    if (governor_lock == NULL)
+        return;
+
+    xSemaphoreTake(governor_lock, portMAX_DELAY);
+    now = esp_timer_get_time();
+    if (!boosted)
+    {
+        esp_pm_lock_acquire(boost_lock);
+        boosted = true;
+        boost_begin = now;
+        ++boost_count;
+    }
+
+    decay_us = (int64_t)governor_get_decay() * 1000;
+    boost_deadline = now + decay_us;
+    esp_timer_stop(decay_timer);
+    esp_timer_start_once(decay_timer, decay_us);
+    xSemaphoreGive(governor_lock);
+}
+
+void governor_get_stats(governor_stats_t *stats)
+{
+    int64_t now;
+
+    if (governor_lock == NULL)
+    {
+        *stats = (governor_stats_t){0};
+        return;
+    }
+
+    xSemaphoreTake(governor_lock, portMAX_DELAY);
+    now = esp_timer_get_time();
+    stats->min_mhz = pm_config.min_freq_mhz;
+    stats->max_mhz = pm_config.max_freq_mhz;
+    stats->boost_ms = (boost_total + (boosted ? now - boost_begin : 0)) / 1000;
+    stats->scaled_ms = (now - init_time) / 1000 - stats->boost_ms;
+    stats->boosts = boost_count;
+    xSemaphoreGive(governor_lock);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint32_t min_mhz;
+    uint32_t max_mhz;
+    uint64_t boost_ms; // held at max_mhz by a boost
+    uint64_t scaled_ms; // the rest, scaled between min_mhz and max_mhz by the pm locks
+    unsigned int boosts;
+} governor_stats_t;
+
+// configure the dynamic frequency scaling between min_mhz and max_mhz,
+// a boost keeps the CPU at max_mhz until decay_ms pass without another one
+bool governor_init(uint32_t min_mhz, uint32_t max_mhz, uint32_t decay_ms);
+// takes effect with the next boost
+void governor_set_decay(uint32_t decay_ms);
+uint32_t governor_get_decay(void);
+
+// safe to call from any task, cheap while the boost is already held
+void governor_boost(void);
+
+void governor_get_stats(governor_stats_t *stats);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// CRC-32/ISO-HDLC (zlib, Ethernet), the value is inverted inside,
+// so a running crc starts at CRC32_INIT and chains through the calls
+#define CRC32_INIT (0)
+uint32_t crc32_update(uint32_t crc, const void *data, size_t len);
+
+// CRC-16/CCITT-FALSE
+#define CRC16_INIT (0xFFFF)
+uint16_t crc16_update(uint16_t crc, const void *data, size_t len);
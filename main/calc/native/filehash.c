@@ -0,0 +1,171 @@
+#include "filehash.h"
+
+#include <string.h>
+
+#include <esp_heap_caps.h>
+#include <hexowl.h>
+#include <mbedtls/sha256.h>
+
+#include "crc.h"
+#include "sdcard.h"
+
+// multiple of the sector size in DMA capable memory lets FATFS read
+// straight into the buffer without the bounce copy
+#define CHUNK_LEN       (16 * 1024)
+#define ADLER_MOD       (65521)
+// largest block before the adler sums have to be reduced
+#define ADLER_NMAX      (5552)
+
+typedef void (*hash_update_t)(void *ctx, const uint8_t *data, size_t len);
+
+typedef struct {
+    uint32_t a;
+    uint32_t b;
+} adler32_t;
+
+static volatile bool interrupted;
+
+static const char *hash_file(const hexowl_value_t *name, hash_update_t update, void *ctx)
+{
+    char fname[SDCARD_MAX_FILE_NAME + 1];
+    const char *err = NULL;
+    sdcard_file_t f;
+    uint8_t *buf;
+    int n;
+
+    if (name->kind != HEXOWL_RESULT_STRING)
+        return "file name expected";
+    if (name->str.n > SDCARD_MAX_FILE_NAME)
+        return "too long file name";
+
+    memcpy(fname, name->str.p, name->str.n);
+    fname[name->str.n] = 0;
+
+    if (!sdcard_is_mounted() && sdcard_mount() != SD_OK)
+        return "no SD card";
+
+    buf = heap_caps_aligned_alloc(4, CHUNK_LEN, MALLOC_CAP_DMA);
+    if (buf == NULL)
+        return "out of memory";
+
+    // the name is taken as typed, without the ".json" of the environment files
+    if (sdcard_file_open(&f, fname, "r") != SD_OK)
+    {
+        heap_caps_free(buf);
+        return "unable to open file";
+    }
+
+    while ((n = sdcard_file_read(f, buf, CHUNK_LEN)) > 0)
+    {
+        if (interrupted)
+        {
+            err = "interrupted";
+            break;
+        }
+        update(ctx, buf, n);
+    }
+
+    if (n < 0)
+        err = "read error";
+
+    sdcard_file_close(f);
+    heap_caps_free(buf);
+    return err;
+}
+
+static void crc32_chunk(void *ctx, const uint8_t *data, size_t len)
+{
+    uint32_t *crc = ctx;
+    *crc = crc32_update(*crc, data, len);
+}
+
+static void adler32_chunk(void *ctx, const uint8_t *data, size_t len)
+{
+    adler32_t *s = ctx;
+
+    while (len > 0)
+    {
+        size_t block = (len < ADLER_NMAX) ? len : ADLER_NMAX;
+
+        len -= block;
+        while (block--)
+        {
+            s->a += *data++;
+            s->b += s->a;
+        }
+        s->a %= ADLER_MOD;
+        s->b %= ADLER_MOD;
+    }
+}
+
+static void sha256_chunk(void *ctx, const uint8_t *data, size_t len)
+{
+    mbedtls_sha256_update(ctx, data, len);
+}
+
+const char *filehash_crc32(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint32_t crc = CRC32_INIT;
+    const char *err;
+
+    if ((err = hash_file(&args[0], crc32_chunk, &crc)) != NULL)
+        return err;
+
+    ret->kind = HEXOWL_RESULT_UINT;
+    ret->raw = crc;
+    return NULL;
+}
+
+const char *filehash_adler32(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    adler32_t s = {1, 0};
+    const char *err;
+
+    if ((err = hash_file(&args[0], adler32_chunk, &s)) != NULL)
+        return err;
+
+    ret->kind = HEXOWL_RESULT_UINT;
+    ret->raw = (s.b << 16) | s.a;
+    return NULL;
+}
+
+const char *filehash_sha256(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    static const char hex[] = "0123456789abcdef";
+    // returned string has to stay valid until hexowl copies it
+    static char digest_str[64];
+    mbedtls_sha256_context ctx;
+    uint8_t digest[32];
+    const char *err;
+
+    mbedtls_sha256_init(&ctx);
+    mbedtls_sha256_starts(&ctx, 0);
+
+    err = hash_file(&args[0], sha256_chunk, &ctx);
+    if (err == NULL)
+        mbedtls_sha256_finish(&ctx, digest);
+    mbedtls_sha256_free(&ctx);
+
+    if (err != NULL)
+        return err;
+
+    for (int i = 0; i < sizeof(digest); ++i)
+    {
+        digest_str[i * 2] = hex[digest[i] >> 4];
+        digest_str[i * 2 + 1] = hex[digest[i] & 0x0F];
+    }
+
+    ret->kind = HEXOWL_RESULT_STRING;
+    ret->str = (GoString){digest_str, sizeof(digest_str)};
+    return NULL;
+}
+
+void filehash_interrupt(void)
+{
+    interrupted = true;
+}
+
+void filehash_reset(void)
+{
+    interrupted = false;
+}
@@ -0,0 +1,14 @@
+#pragma once
+
+struct hexowl_value;
+
+// builtins hashing a file from the SD card environment directory chunk by chunk
+const char *filehash_crc32(const struct hexowl_value *args, int argc, struct hexowl_value *ret);
+const char *filehash_adler32(const struct hexowl_value *args, int argc, struct hexowl_value *ret);
+// the digest is returned as a hex string
+const char *filehash_sha256(const struct hexowl_value *args, int argc, struct hexowl_value *ret);
+
+// stop the running hash, it returns an error; the stop lasts until the reset,
+// so an interrupt that comes before the hash opens its file is not lost
+void filehash_interrupt(void);
+void filehash_reset(void);
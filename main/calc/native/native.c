@@ -0,0 +1,316 @@
+#include "native.h"
+
+#include <string.h>
+#include <hexowl.h>
+
+#include "crc.h"
+#include "filehash.h"
+#include "../format/numfmt.h"
+#include "../governor/governor.h"
+
+// a longer boost would keep the CPU at full speed for good
+#define DECAY_MAX (60000)
+
+typedef struct {
+    const char *name;
+    const char *args;
+    const char *desc;
+    uint8_t min_args;
+    uint8_t max_args;
+    uint8_t flags;
+    hexowl_native_func_t func;
+} native_builtin_t;
+
+const char *native_arg_uint(const hexowl_value_t *v, uint64_t *out)
+{
+    double f;
+
+    switch (v->kind)
+    {
+    case HEXOWL_RESULT_UINT:
+    case HEXOWL_RESULT_INT:
+    case HEXOWL_RESULT_BOOL:
+        *out = v->raw;
+        return NULL;
+    case HEXOWL_RESULT_FLOAT:
+        // same as the integer conversion of the result output
+        memcpy(&f, &v->raw, sizeof(f));
+        *out = numfmt_float_int(f);
+        return NULL;
+    default:
+        return "number expected";
+    }
+}
+
+static const char *arg_float(const hexowl_value_t *v, double *out)
+{
+    switch (v->kind)
+    {
+    case HEXOWL_RESULT_FLOAT:
+        memcpy(out, &v->raw, sizeof(*out));
+        return NULL;
+    case HEXOWL_RESULT_UINT:
+        *out = v->raw;
+        return NULL;
+    case HEXOWL_RESULT_INT:
+        *out = (int64_t)v->raw;
+        return NULL;
+    default:
+        return "number expected";
+    }
+}
+
+// optional width argument limited to 1..max
+static const char *arg_width(const hexowl_value_t *args, int argc, int idx, uint64_t def, uint64_t max, uint64_t *out)
+{
+    const char *err;
+
+    if (argc <= idx)
+    {
+        *out = def;
+        return NULL;
+    }
+
+    if ((err = native_arg_uint(&args[idx], out)) != NULL)
+        return err;
+    if (*out < 1 || *out > max)
+        return "width out of range";
+
+    return NULL;
+}
+
+void native_ret_uint(hexowl_value_t *ret, uint64_t val)
+{
+    ret->kind = HEXOWL_RESULT_UINT;
+    ret->raw = val;
+}
+
+static void ret_float(hexowl_value_t *ret, double val)
+{
+    ret->kind = HEXOWL_RESULT_FLOAT;
+    memcpy(&ret->raw, &val, sizeof(val));
+}
+
+static const char *native_popcnt(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t x;
+    const char *err;
+
+    if ((err = native_arg_uint(&args[0], &x)) != NULL)
+        return err;
+
+    native_ret_uint(ret, __builtin_popcountll(x));
+    return NULL;
+}
+
+static const char *native_bitrev(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t x, bits, r = 0;
+    const char *err;
+
+    if ((err = native_arg_uint(&args[0], &x)) != NULL)
+        return err;
+    if ((err = arg_width(args, argc, 1, 64, 64, &bits)) != NULL)
+        return err;
+
+    // swap the halves down to the single bits, then drop the unused low part
+    r = x;
+    r = ((r >> 1) & 0x5555555555555555ULL) | ((r & 0x5555555555555555ULL) << 1);
+    r = ((r >> 2) & 0x3333333333333333ULL) | ((r & 0x3333333333333333ULL) << 2);
+    r = ((r >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((r & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    r = __builtin_bswap64(r);
+
+    native_ret_uint(ret, r >> (64 - bits));
+    return NULL;
+}
+
+static const char *native_bswap(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t x, bytes;
+    const char *err;
+
+    if ((err = native_arg_uint(&args[0], &x)) != NULL)
+        return err;
+    if ((err = arg_width(args, argc, 1, 8, 8, &bytes)) != NULL)
+        return err;
+
+    native_ret_uint(ret, __builtin_bswap64(x) >> (64 - bytes * 8));
+    return NULL;
+}
+
+// a string is taken as its bytes, a number as its little endian bytes
+static const char *crc_data(const hexowl_value_t *args, int argc, uint8_t *buf, const void **data, size_t *len)
+{
+    uint64_t x, bytes;
+    const char *err;
+
+    if (args[0].kind == HEXOWL_RESULT_STRING)
+    {
+        if (argc > 1)
+            return "width is only for numbers";
+        *data = args[0].str.p;
+        *len = args[0].str.n;
+        return NULL;
+    }
+
+    if ((err = native_arg_uint(&args[0], &x)) != NULL)
+        return err;
+    if ((err = arg_width(args, argc, 1, 4, 8, &bytes)) != NULL)
+        return err;
+
+    for (int i = 0; i < bytes; ++i)
+        buf[i] = x >> (i * 8);
+
+    *data = buf;
+    *len = bytes;
+    return NULL;
+}
+
+static const char *native_crc32(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint8_t buf[8];
+    const void *data;
+    size_t len;
+    const char *err;
+
+    if ((err = crc_data(args, argc, buf, &data, &len)) != NULL)
+        return err;
+
+    native_ret_uint(ret, crc32_update(CRC32_INIT, data, len));
+    return NULL;
+}
+
+static const char *native_crc16(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint8_t buf[8];
+    const void *data;
+    size_t len;
+    const char *err;
+
+    if ((err = crc_data(args, argc, buf, &data, &len)) != NULL)
+        return err;
+
+    native_ret_uint(ret, crc16_update(CRC16_INIT, data, len));
+    return NULL;
+}
+
+static const char *native_f64bits(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    double f;
+    uint64_t bits;
+    const char *err;
+
+    if ((err = arg_float(&args[0], &f)) != NULL)
+        return err;
+
+    memcpy(&bits, &f, sizeof(bits));
+    native_ret_uint(ret, bits);
+    return NULL;
+}
+
+static const char *native_bitsf64(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t bits;
+    double f;
+    const char *err;
+
+    if ((err = native_arg_uint(&args[0], &bits)) != NULL)
+        return err;
+
+    memcpy(&f, &bits, sizeof(f));
+    ret_float(ret, f);
+    return NULL;
+}
+
+static const char *native_f32bits(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    double f;
+    float f32;
+    uint32_t bits;
+    const char *err;
+
+    if ((err = arg_float(&args[0], &f)) != NULL)
+        return err;
+
+    f32 = f;
+    memcpy(&bits, &f32, sizeof(bits));
+    native_ret_uint(ret, bits);
+    return NULL;
+}
+
+static const char *native_bitsf32(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t bits;
+    uint32_t bits32;
+    float f32;
+    const char *err;
+
+    if ((err = native_arg_uint(&args[0], &bits)) != NULL)
+        return err;
+    if (bits > UINT32_MAX)
+        return "value does not fit 32 bits";
+
+    bits32 = bits;
+    memcpy(&f32, &bits32, sizeof(f32));
+    ret_float(ret, f32);
+    return NULL;
+}
+
+static const char *native_boost(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t decay;
+    const char *err;
+
+    if (argc > 0)
+    {
+        if ((err = native_arg_uint(&args[0], &decay)) != NULL)
+            return err;
+        if (decay > DECAY_MAX)
+            return "decay out of range";
+        governor_set_decay(decay);
+    }
+
+    native_ret_uint(ret, governor_get_decay());
+    return NULL;
+}
+
+static const native_builtin_t builtins[] = {
+    {"popcnt", "(x)", "count of set bits", 1, 1, 0, native_popcnt},
+    {"bitrev", "(x, [bits=64])", "reverse the low bits", 1, 2, 0, native_bitrev},
+    {"bswap", "(x, [bytes=8])", "reverse the low bytes", 1, 2, 0, native_bswap},
+    {"crc32", "(data, [bytes=4])", "CRC-32 of a string or the little endian bytes of a number", 1, 2, 0, native_crc32},
+    {"crc16", "(data, [bytes=4])", "CRC-16/CCITT-FALSE of a string or the little endian bytes of a number", 1, 2, 0, native_crc16},
+    {"f64bits", "(x)", "IEEE 754 bits of a double", 1, 1, 0, native_f64bits},
+    {"bitsf64", "(x)", "double from IEEE 754 bits", 1, 1, 0, native_bitsf64},
+    {"f32bits", "(x)", "IEEE 754 bits of a float", 1, 1, 0, native_f32bits},
+    {"bitsf32", "(x)", "float from IEEE 754 bits", 1, 1, 0, native_bitsf32},
+    {"crc32f", "(name)", "CRC-32 of an SD card file", 1, 1, HEXOWL_NATIVE_IMPURE, filehash_crc32},
+    {"adler32f", "(name)", "Adler-32 of an SD card file", 1, 1, HEXOWL_NATIVE_IMPURE, filehash_adler32},
+    {"sha256f", "(name)", "SHA-256 hex digest of an SD card file", 1, 1, HEXOWL_NATIVE_IMPURE, filehash_sha256},
+    {"boost", "([ms])", "CPU boost decay after the last key or result, 0 drops it at once", 0, 1, HEXOWL_NATIVE_IMPURE, native_boost},
+};
+
+static GoString go_string(const char *str)
+{
+    return (GoString){str, strlen(str)};
+}
+
+void native_register(void)
+{
+    for (int i = 0; i < sizeof(builtins) / sizeof(builtins[0]); ++i)
+    {
+        const native_builtin_t *b = &builtins[i];
+        HexowlRegisterNative(go_string(b->name), go_string(b->args), go_string(b->desc),
+                             b->min_args, b->max_args, b->flags, b->func);
+    }
+}
+
+void native_interrupt(void)
+{
+    filehash_interrupt();
+}
+
+void native_reset(void)
+{
+    filehash_reset();
+}
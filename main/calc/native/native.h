@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdint.h>
+
+struct hexowl_value;
+
+// register the builtins implemented in C, call after HexowlInit
+void native_register(void);
+// stop a long running builtin like a file hash
+void native_interrupt(void);
+// clear the interrupt of the previous request, call when a request begins
+void native_reset(void);
+
+// argument and result helpers for the builtins of other modules:
+// a number argument as an integer, NULL or the error to return
+const char *native_arg_uint(const struct hexowl_value *v, uint64_t *out);
+void native_ret_uint(struct hexowl_value *ret, uint64_t val);
@@ -0,0 +1,91 @@
+#include "perf.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define PERF_UNSET (UINT32_MAX)
+
+perf_t *perf_init(int phases, int count)
+{
+    if (phases <= 0 || count <= 0) return NULL;
+
+    perf_t *p = malloc(sizeof(perf_t));
+    if (p == NULL) return NULL;
+
+    memset(p, 0, sizeof(perf_t));
+    p->samples = malloc(sizeof(uint32_t) * phases * count);
+    p->scratch = malloc(sizeof(uint32_t) * count);
+    if (p->samples == NULL || p->scratch == NULL)
+    {
+        perf_deinit(p);
+        return NULL;
+    }
+
+    memset(p->samples, 0xFF, sizeof(uint32_t) * phases * count);
+    p->phases = phases;
+    p->count = count;
+    return p;
+}
+
+void perf_deinit(perf_t *p)
+{
+    free(p->samples);
+    free(p->scratch);
+    free(p);
+}
+
+unsigned int perf_begin(perf_t *p)
+{
+    unsigned int sample = p->next;
+    uint32_t *s = &p->samples[(sample % p->count) * p->phases];
+
+    for (int i = 0; i < p->phases; ++i)
+        __atomic_store_n(&s[i], PERF_UNSET, __ATOMIC_RELAXED);
+
+    __atomic_store_n(&p->next, sample + 1, __ATOMIC_RELEASE);
+    return sample;
+}
+
+void perf_record(perf_t *p, unsigned int sample, int phase, uint32_t us)
+{
+    if (phase < 0 || phase >= p->phases) return;
+
+    // the slot was already taken by a newer sample
+    if (__atomic_load_n(&p->next, __ATOMIC_ACQUIRE) - sample > (unsigned int)p->count) return;
+
+    // keep the unset marker distinguishable
+    if (us == PERF_UNSET)
+        --us;
+
+    __atomic_store_n(&p->samples[(sample % p->count) * p->phases + phase], us, __ATOMIC_RELAXED);
+}
+
+int perf_stats(perf_t *p, int phase, uint32_t *min, uint32_t *median, uint32_t *p99)
+{
+    int n = 0;
+
+    if (phase < 0 || phase >= p->phases) return 0;
+
+    for (int i = 0; i < p->count; ++i)
+    {
+        uint32_t v = __atomic_load_n(&p->samples[i * p->phases + phase], __ATOMIC_RELAXED);
+        if (v == PERF_UNSET)
+            continue;
+
+        // insertion sort, the ring is small
+        int j = n++;
+        while (j > 0 && p->scratch[j - 1] > v)
+        {
+            p->scratch[j] = p->scratch[j - 1];
+            --j;
+        }
+        p->scratch[j] = v;
+    }
+
+    if (n == 0) return 0;
+
+    *min = p->scratch[0];
+    *median = p->scratch[n / 2];
+    *p99 = p->scratch[(n * 99 + 99) / 100 - 1];
+    return n;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <stdint.h>
+
+// ring of the latest timing samples, each holds a duration in microseconds per phase;
+// the phases of a sample may be recorded from different tasks
+typedef struct {
+    uint32_t *samples;
+    uint32_t *scratch;
+    int phases;
+    int count;
+    unsigned int next;
+} perf_t;
+
+perf_t *perf_init(int phases, int count);
+void perf_deinit(perf_t *p);
+
+// start a new sample with every phase unset, returns its id for perf_record
+unsigned int perf_begin(perf_t *p);
+void perf_record(perf_t *p, unsigned int sample, int phase, uint32_t us);
+
+// min, median and 99th percentile of a phase, returns the count of the recorded values
+int perf_stats(perf_t *p, int phase, uint32_t *min, uint32_t *median, uint32_t *p99);
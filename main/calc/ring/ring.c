@@ -0,0 +1,86 @@
+#include "ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+ring_t *ring_init(size_t size)
+{
+    if (size == 0 || (size & (size - 1)) != 0) return NULL;
+
+    ring_t *r = malloc(sizeof(ring_t));
+    if (r == NULL) return NULL;
+
+    memset(r, 0, sizeof(ring_t));
+    r->buf = malloc(size);
+    if (r->buf == NULL)
+    {
+        free(r);
+        return NULL;
+    }
+
+    r->size = size;
+    return r;
+}
+
+void ring_deinit(ring_t *r)
+{
+    free(r->buf);
+    free(r);
+}
+
+size_t ring_used(const ring_t *r)
+{
+    size_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    size_t tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    return head - tail;
+}
+
+size_t ring_free(const ring_t *r)
+{
+    return r->size - ring_used(r);
+}
+
+size_t ring_write(ring_t *r, const void *data, size_t len)
+{
+    size_t head = r->head;
+    size_t tail = __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE);
+    size_t space = r->size - (head - tail);
+    size_t offset = head & (r->size - 1);
+    size_t first;
+
+    if (len > space)
+        len = space;
+
+    first = r->size - offset;
+    if (first > len)
+        first = len;
+
+    memcpy(&r->buf[offset], data, first);
+    memcpy(r->buf, (const char *)data + first, len - first);
+
+    __atomic_store_n(&r->head, head + len, __ATOMIC_RELEASE);
+
+    if (head + len - tail > r->high_water)
+        r->high_water = head + len - tail;
+
+    return len;
+}
+
+size_t ring_peek(const ring_t *r, const char **data)
+{
+    size_t head = __atomic_load_n(&r->head, __ATOMIC_ACQUIRE);
+    size_t tail = r->tail;
+    size_t offset = tail & (r->size - 1);
+    size_t len = head - tail;
+
+    if (len > r->size - offset)
+        len = r->size - offset;
+
+    *data = &r->buf[offset];
+    return len;
+}
+
+void ring_consume(ring_t *r, size_t len)
+{
+    __atomic_store_n(&r->tail, r->tail + len, __ATOMIC_RELEASE);
+}
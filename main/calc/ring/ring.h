@@ -0,0 +1,25 @@
+#pragma once
+
+#include <stddef.h>
+
+// single producer single consumer byte ring, size must be a power of two
+typedef struct {
+    char *buf;
+    size_t size;
+    size_t head;
+    size_t tail;
+    size_t high_water;
+} ring_t;
+
+ring_t *ring_init(size_t size);
+void ring_deinit(ring_t *r);
+
+size_t ring_used(const ring_t *r);
+size_t ring_free(const ring_t *r);
+
+// producer side, returns the count of bytes actually stored
+size_t ring_write(ring_t *r, const void *data, size_t len);
+
+// consumer side, returns the length of the contiguous readable span
+size_t ring_peek(const ring_t *r, const char **data);
+void ring_consume(ring_t *r, size_t len);
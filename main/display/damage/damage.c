@@ -0,0 +1,160 @@
+#include "damage.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <esp_heap_caps.h>
+
+// a column address covers 4 pixels
+#define COLUMN_BYTES        (2)
+// every window costs its commands on top of the pixels: column and row address
+// with two bytes each and write RAM
+#define WINDOW_COST         (7)
+
+damage_t *damage_init(ssd1322_t *display, panel_t *panel)
+{
+    size_t size = display->res_x * display->res_y / 2;
+
+    damage_t *dmg = malloc(sizeof(damage_t));
+    if (dmg == NULL) return NULL;
+
+    memset(dmg, 0, sizeof(damage_t));
+    dmg->display = display;
+    dmg->panel = panel;
+    dmg->shadow = malloc(size);
+    dmg->front = heap_caps_malloc(size, MALLOC_CAP_DMA);
+    dmg->rows = malloc(display->res_y * sizeof(damage_row_t));
+    if (dmg->shadow == NULL || dmg->front == NULL || dmg->rows == NULL)
+    {
+        damage_deinit(dmg);
+        return NULL;
+    }
+
+    dmg->full = true;
+    return dmg;
+}
+
+void damage_deinit(damage_t *dmg)
+{
+    damage_wait(dmg);
+    free(dmg->shadow);
+    heap_caps_free(dmg->front);
+    free(dmg->rows);
+    free(dmg);
+}
+
+void damage_wait(damage_t *dmg)
+{
+    panel_wait(dmg->panel);
+}
+
+// bytes from first to last differ from the sent frame, rounded to whole columns
+static bool row_damage(damage_t *dmg, int y, damage_row_t *row)
+{
+    int stride = dmg->display->res_x / 2;
+    const uint8_t *fb = &dmg->display->framebuffer[y * stride];
+    const uint8_t *sh = &dmg->shadow[y * stride];
+    int l = 0, r = stride - 1;
+
+    if (memcmp(fb, sh, stride) == 0)
+        return false;
+
+    while (fb[l] == sh[l]) ++l;
+    while (fb[r] == sh[r]) --r;
+
+    row->y = y;
+    row->first = l - l % COLUMN_BYTES;
+    row->last = r - r % COLUMN_BYTES + COLUMN_BYTES - 1;
+    return true;
+}
+
+// copies the window into the front buffer at *fill and queues it
+static uint32_t send_window(damage_t *dmg, int y0, int y1, int first, int last, size_t *fill)
+{
+    int stride = dmg->display->res_x / 2;
+    int w = last - first + 1;
+    size_t len = w * (y1 - y0 + 1);
+    uint8_t *data = &dmg->front[*fill];
+
+    // pack the window rows and remember them as sent
+    for (int y = y0; y <= y1; ++y)
+    {
+        memcpy(&data[(y - y0) * w], &dmg->display->framebuffer[y * stride + first], w);
+        memcpy(&dmg->shadow[y * stride + first], &dmg->display->framebuffer[y * stride + first], w);
+    }
+    *fill += len;
+
+    return panel_write_window(dmg->panel, first / COLUMN_BYTES, last / COLUMN_BYTES, y0, y1, data, len);
+}
+
+// splits the dirty rows into the windows that send the fewest bytes; a window
+// spans the rows between its first and last dirty one, clean ones included,
+// with the columns of all of them, so it pays off only while the rows are close
+static void plan_windows(damage_row_t *rows, int count)
+{
+    for (int i = count - 1; i >= 0; --i)
+    {
+        int first = rows[i].first, last = rows[i].last;
+
+        rows[i].cost = UINT32_MAX;
+        for (int j = i; j < count; ++j)
+        {
+            if (rows[j].first < first) first = rows[j].first;
+            if (rows[j].last > last) last = rows[j].last;
+
+            uint32_t cost = WINDOW_COST + (last - first + 1) * (rows[j].y - rows[i].y + 1);
+            if (j + 1 < count)
+                cost += rows[j + 1].cost;
+
+            if (cost < rows[i].cost)
+            {
+                rows[i].cost = cost;
+                rows[i].window_end = j;
+            }
+        }
+    }
+}
+
+uint32_t damage_flush(damage_t *dmg)
+{
+    int count = 0;
+    uint32_t sent = 0;
+    size_t fill = 0;
+
+    // the front buffer may still be in transfer
+    damage_wait(dmg);
+
+    if (dmg->full)
+    {
+        dmg->full = false;
+        sent = send_window(dmg, 0, dmg->display->res_y - 1, 0, dmg->display->res_x / 2 - 1, &fill);
+        goto done;
+    }
+
+    for (int y = 0; y < dmg->display->res_y; ++y)
+    {
+        if (row_damage(dmg, y, &dmg->rows[count]))
+            ++count;
+    }
+
+    plan_windows(dmg->rows, count);
+
+    for (int i = 0; i < count; i = dmg->rows[i].window_end + 1)
+    {
+        int first = dmg->rows[i].first, last = dmg->rows[i].last;
+
+        for (int j = i + 1; j <= dmg->rows[i].window_end; ++j)
+        {
+            if (dmg->rows[j].first < first) first = dmg->rows[j].first;
+            if (dmg->rows[j].last > last) last = dmg->rows[j].last;
+        }
+
+        sent += send_window(dmg, dmg->rows[i].y, dmg->rows[dmg->rows[i].window_end].y, first, last, &fill);
+    }
+
+done:
+    ++dmg->frames;
+    dmg->last_bytes = sent;
+    dmg->total_bytes += sent;
+    return sent;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../ssd1322/ssd1322.h"
+#include "../panel/panel.h"
+
+// a row that differs from the sent frame, the bytes first to last changed
+typedef struct {
+    int16_t y;
+    int16_t first;
+    int16_t last;
+    // the cheapest way to send this and the following dirty rows:
+    // its cost in bytes and the last row of the first window
+    int16_t window_end;
+    uint32_t cost;
+} damage_row_t;
+
+// keeps the last frame sent to the panel and transfers only the changed windows;
+// the framebuffer is the back buffer, the changed windows are copied into the
+// front buffer and DMA'd from it while the next frame is drawn
+typedef struct {
+    ssd1322_t *display;
+    panel_t *panel;
+    uint8_t *shadow;
+    uint8_t *front;
+    damage_row_t *rows;
+    bool full;
+    uint32_t frames;
+    uint32_t last_bytes;
+    uint64_t total_bytes;
+} damage_t;
+
+// the first flush sends the whole framebuffer
+damage_t *damage_init(ssd1322_t *display, panel_t *panel);
+void damage_deinit(damage_t *dmg);
+
+// queue the windows changed since the last flush, waits for the previous transfer
+// only before reusing the front buffer, returns the bytes sent over SPI
+uint32_t damage_flush(damage_t *dmg);
+// block until the last flush is on the panel
+void damage_wait(damage_t *dmg);
@@ -0,0 +1,464 @@
+//	cascadia packed font
+//
+//	Memory usage
+//		Data: 3009
+//		Glyph descriptors: 950
+//
+//		Total: 3959 (source bitmaps: 9120)
+//
+
+#include "cascadia_pack.h"
+
+static const uint8_t __font_cascadia_pack_data[] = {
+	// '!' (0x21)
+	0x03,0x30,0x08,0x90,0x08,0x80,0x08,0x80,0x08,0x80,0x07,0x70,0x02,0x20,0x05,0x50,0x0B,0xB0,
+	// '"' (0x22)
+	0x33,0x33,0x9A,0x9A,0x99,0x99,0x89,0x89,0x33,0x33,
+	// '#' (0x23)
+	0x00,0x22,0x04,0x00,0x00,0x78,0x0E,0x10,0x02,0xCA,0x3B,0x30,0x0A,0x8C,0xD4,0xB0,0x00,0xB4,0x3C,0x00,0x01,0xE4,0x6C,0x10,0x0C,0x2F,0xB6,0xC0,0x00,0xE0,0x68,0x00,
+	0x01,0xE0,0x87,0x00,
+	// '$' (0x24)
+	0x00,0x04,0x70,0x00,0x00,0x1A,0xD2,0x00,0x02,0xEE,0xBE,0x60,0x06,0xC4,0x72,0x00,0x05,0xD7,0x70,0x00,0x00,0xAA,0xC2,0x00,0x00,0x08,0xBE,0x30,0x00,0x04,0x7A,0x90,
+	0x04,0x24,0x8B,0x80,0x08,0xEA,0x7B,0x10,0x00,0x06,0x70,0x00,0x00,0x04,0x60,0x00,
+	// '%' (0x25)
+	0x01,0x53,0x00,0x00,0x0D,0x8D,0x30,0x00,0x2D,0x09,0x60,0x30,0x0C,0xAD,0x4B,0x90,0x00,0x47,0xD5,0x00,0x00,0x9C,0x79,0x50,0x0A,0x82,0xD5,0xD2,0x00,0x04,0xB0,0xC4,
+	0x00,0x00,0xBD,0xB0,0x00,0x00,0x01,0x00,
+	// '&' (0x26)
+	0x00,0x05,0x51,0x00,0x00,0xCC,0xBE,0x10,0x03,0xE0,0x06,0x10,0x03,0xF1,0x00,0x00,0x00,0xEB,0x01,0x60,0x08,0xEC,0x85,0xB0,0x1F,0x23,0xED,0x80,0x1E,0x40,0x91,0x70,
+	0x06,0xEE,0xD9,0xE3,0x00,0x01,0x00,0x00,
+	// "'" (0x27)
+	0x03,0x30,0x09,0xA0,0x09,0x90,0x08,0x90,0x03,0x30,
+	// '(' (0x28)
+	0x00,0x26,0x20,0x07,0xE9,0x20,0x3E,0x30,0x00,0x9A,0x00,0x00,0xC6,0x00,0x00,0xD4,0x00,0x00,0xD5,0x00,0x00,0xB7,0x00,0x00,0x8C,0x00,0x00,0x1E,0x80,0x00,0x03,0xCE,
+	0x40,0x00,0x01,0x00,
+	// ')' (0x29)
+	0x02,0x62,0x00,0x02,0x9E,0x70,0x00,0x03,0xE4,0x00,0x00,0xAA,0x00,0x00,0x6C,0x00,0x00,0x4E,0x00,0x00,0x5D,0x00,0x00,0x6C,0x00,0x00,0xC8,0x00,0x07,0xE1,0x04,0xEC,
+	0x30,0x00,0x10,0x00,
+	// '*' (0x2A)
+	0x00,0x07,0x80,0x00,0x04,0x37,0x83,0x40,0x07,0xE9,0x8E,0x80,0x00,0x3B,0xB3,0x00,0x01,0xD5,0x5E,0x10,0x00,0x30,0x03,0x00,
+	// '+' (0x2B)
+	0x00,0x01,0x10,0x00,0x00,0x09,0x90,0x00,0x00,0x09,0x90,0x00,0x09,0xAA,0x9A,0xA0,0x05,0x5F,0xE5,0x50,0x00,0x09,0x90,0x00,0x00,0x08,0x80,0x00,
+	// ',' (0x2C)
+	0x04,0x50,0x0B,0x80,0x0C,0x60,0x0E,0x30,
+	// '-' (0x2D)
+	0x09,0xAA,0xAA,0xA0,0x05,0x55,0x55,0x50,
+	// '.' (0x2E)
+	0x05,0x50,0x0B,0xB0,
+	// '/' (0x2F)
+	0x00,0x00,0x01,0x60,0x00,0x00,0x08,0xA0,0x00,0x00,0x0E,0x30,0x00,0x00,0x6C,0x00,0x00,0x00,0xD5,0x00,0x00,0x05,0xD0,0x00,0x00,0x0B,0x60,0x00,0x00,0x3E,0x00,0x00,
+	0x00,0xA8,0x00,0x00,0x01,0xE1,0x00,0x00,0x08,0xA0,0x00,0x00,0x01,0x00,0x00,0x00,
+	// '0' (0x30)
+	0x00,0x15,0x51,0x00,0x01,0xDC,0xCD,0x10,0x07,0xC0,0x0C,0x70,0x0A,0x80,0x08,0xB0,0x0C,0x6A,0xA6,0xC0,0x0B,0x77,0x76,0xC0,0x0A,0x90,0x09,0xA0,0x05,0xE2,0x2D,0x60,
+	0x00,0x9E,0xE9,0x00,
+	// '1' (0x31)
+	0x00,0x04,0x30,0x00,0x04,0xDE,0xC0,0x00,0x02,0x36,0xC0,0x00,0x00,0x06,0xC0,0x00,0x00,0x06,0xC0,0x00,0x00,0x06,0xC0,0x00,0x00,0x06,0xC0,0x00,0x00,0x17,0xC1,0x10,
+	0x07,0xFD,0xDF,0xA0,
+	// '2' (0x32)
+	0x00,0x26,0x50,0x00,0x07,0xEA,0xCD,0x10,0x03,0x20,0x0D,0x50,0x00,0x00,0x0D,0x50,0x00,0x00,0x2E,0x20,0x00,0x00,0xC8,0x00,0x00,0x1C,0xA0,0x00,0x05,0xE9,0x11,0x10,
+	0x0C,0x0B,0xFF,0xC0,
+	// '3' (0x33)
+	0x00,0x25,0x51,0x00,0x06,0xEA,0xBE,0x20,0x01,0x20,0x0C,0x50,0x00,0x00,0x3D,0x10,0x00,0x6A,0xB3,0x00,0x00,0x16,0x9E,0x30,0x00,0x00,0x0A,0x80,0x01,0x00,0x2D,0x60,
+	0x07,0xFE,0xE9,0x00,0x00,0x01,0x00,0x00,
+	// '4' (0x34)
+	0x00,0x00,0x04,0x10,0x00,0xC3,0x0E,0x40,0x02,0xF1,0x0E,0x40,0x05,0xD0,0x0E,0x40,0x08,0xA0,0x0E,0x40,0x0B,0x70,0x0E,0x40,0x07,0xBE,0xED,0xD0,0x04,0x22,0x2E,0x60,
+	0x00,0x00,0x0E,0x40,
+	// '5' (0x35)
+	0x00,0x85,0x44,0x10,0x02,0x8D,0xBB,0x40,0x02,0xF1,0x00,0x00,0x02,0xE5,0x52,0x00,0x03,0xBA,0xAE,0x50,0x00,0x00,0x08,0xB0,0x03,0x20,0x05,0xD0,0x08,0xC1,0x0A,0xA0,
+	0x01,0xBE,0xEC,0x10,0x00,0x00,0x10,0x00,
+	// '6' (0x36)
+	0x00,0x00,0x14,0x00,0x00,0x1B,0xED,0x20,0x00,0xDA,0x10,0x00,0x06,0xD1,0x31,0x00,0x0A,0xBC,0xCE,0x40,0x0E,0xC0,0x08,0xB0,0x0B,0x80,0x05,0xC0,0x07,0xC1,0x0A,0x90,
+	0x01,0xBE,0xEB,0x10,
+	// '7' (0x37)
+	0x05,0x54,0x45,0x91,0x07,0xCC,0xCC,0x70,0x0C,0x60,0x0A,0x90,0x07,0x30,0x1E,0x40,0x00,0x00,0x6D,0x00,0x00,0x00,0xB8,0x00,0x00,0x01,0xE3,0x00,0x00,0x06,0xD0,0x00,
+	0x00,0x0B,0x80,0x00,
+	// '8' (0x38)
+	0x00,0x15,0x51,0x00,0x03,0xEB,0xBE,0x30,0x08,0xB0,0x0A,0x80,0x05,0xC0,0x0C,0x50,0x00,0x76,0x67,0x00,0x05,0xC3,0x3C,0x60,0x0B,0x60,0x06,0xB0,0x09,0xA0,0x0A,0xA0,
+	0x01,0xBF,0xEB,0x20,
+	// '9' (0x39)
+	0x00,0x04,0x41,0x00,0x02,0xDC,0xCE,0x30,0x09,0x90,0x09,0xA0,0x0B,0x60,0x07,0xE0,0x09,0xB1,0x2D,0xE0,0x02,0xBE,0xBA,0xA0,0x00,0x00,0x1D,0x50,0x00,0x15,0xCB,0x00,
+	0x01,0xFD,0x70,0x00,
+	// ':' (0x3A)
+	0x02,0x20,0x0B,0xC0,0x02,0x30,0x05,0x50,0x0B,0xB0,
+	// ';' (0x3B)
+	0x02,0x20,0x0B,0xC0,0x02,0x30,0x04,0x50,0x0B,0x80,0x0C,0x60,0x0E,0x30,
+	// '<' (0x3C)
+	0x00,0x00,0x28,0x90,0x00,0x5B,0xE9,0x30,0x0D,0xC5,0x00,0x00,0x08,0xEA,0x50,0x00,0x00,0x16,0xCE,0x60,0x00,0x00,0x04,0x60,
+	// '=' (0x3D)
+	0x02,0x22,0x22,0x20,0x0C,0xDD,0xDD,0xD0,0x03,0x33,0x33,0x30,0x0B,0xCC,0xCC,0xC0,
+	// '>' (0x3E)
+	0x08,0x82,0x00,0x00,0x03,0xAE,0xB5,0x00,0x00,0x01,0x6D,0xD0,0x00,0x05,0xBE,0x90,0x06,0xEC,0x61,0x00,0x05,0x40,0x00,0x00,
+	// '?' (0x3F)
+	0x00,0x25,0x51,0x00,0x06,0xEB,0xBE,0x10,0x03,0x30,0x0E,0x50,0x00,0x00,0x4E,0x20,0x00,0x05,0xE5,0x00,0x00,0x0B,0x60,0x00,0x00,0x03,0x10,0x00,0x00,0x07,0x30,0x00,
+	0x00,0x0E,0x80,0x00,
+	// '@' (0x40)
+	0x00,0x05,0x51,0x00,0x00,0xCC,0xAE,0x20,0x06,0xB1,0x47,0x90,0x0A,0x5C,0xCA,0xB0,0x0C,0x4E,0x0A,0xA0,0x0C,0x4D,0x09,0x50,0x0C,0x3E,0x29,0xD0,0x0A,0x59,0xF9,0xB0,
+	0x06,0xB0,0x00,0x00,0x00,0xAD,0xA8,0x00,0x00,0x03,0x54,0x00,
+	// 'A' (0x41)
+	0x00,0x04,0x40,0x00,0x00,0x1E,0xE1,0x00,0x00,0x5B,0xA5,0x00,0x00,0x97,0x6A,0x00,0x00,0xE3,0x2E,0x00,0x03,0xE2,0x2E,0x30,0x09,0x5E,0xE5,0x90,0x0C,0x60,0x05,0xC0,
+	0x1F,0x20,0x01,0xF1,
+	// 'B' (0x42)
+	0x02,0x54,0x40,0x00,0x08,0xEC,0xDD,0x20,0x08,0x90,0x0C,0x70,0x08,0x90,0x1C,0x50,0x08,0x67,0xC7,0x00,0x08,0xA2,0x29,0xA0,0x08,0x90,0x02,0xF1,0x08,0xA1,0x28,0xE0,
+	0x08,0xDF,0xEC,0x40,
+	// 'C' (0x43)
+	0x00,0x03,0x65,0x10,0x00,0xBE,0xAC,0xD0,0x07,0xD1,0x00,0x30,0x0C,0x60,0x00,0x00,0x0E,0x40,0x00,0x00,0x0E,0x50,0x00,0x00,0x0C,0x90,0x00,0x00,0x05,0xE6,0x10,0x20,
+	0x00,0x6D,0xFE,0xC0,0x00,0x00,0x10,0x00,
+	// 'D' (0x44)
+	0x03,0x54,0x20,0x00,0x0A,0xFC,0xEB,0x10,0x0A,0x80,0x1C,0x90,0x0A,0x80,0x04,0xE0,0x0A,0x80,0x02,0xF1,0x0A,0x80,0x02,0xF1,0x0A,0x80,0x06,0xD0,0x0A,0x92,0x5D,0x70,
+	0x0A,0xDE,0xC6,0x00,
+	// 'E' (0x45)
+	0x05,0x84,0x44,0x40,0x0E,0x8C,0xCC,0xB0,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x0E,0x9A,0xA9,0x00,0x0B,0xE5,0x55,0x00,0x08,0x90,0x00,0x00,0x09,0xB1,0x11,0x10,
+	0x0D,0x5F,0xFF,0xE0,
+	// 'F' (0x46)
+	0x04,0x84,0x44,0x40,0x0B,0x6C,0xCC,0xC0,0x06,0xB0,0x00,0x00,0x06,0xB0,0x00,0x00,0x09,0xC5,0x55,0x00,0x0B,0x7B,0xBB,0x00,0x06,0xB0,0x00,0x00,0x06,0xB0,0x00,0x00,
+	0x06,0xB0,0x00,0x00,
+	// 'G' (0x47)
+	0x00,0x04,0x64,0x00,0x01,0xCD,0xAC,0xC0,0x09,0xB0,0x00,0x20,0x0E,0x40,0x00,0x00,0x1F,0x20,0x22,0x40,0x1F,0x30,0xDB,0x40,0x0D,0x60,0x04,0xD0,0x08,0xD4,0x04,0xE0,
+	0x00,0x8E,0xEC,0xA0,0x00,0x00,0x10,0x00,
+	// 'H' (0x48)
+	0x03,0x20,0x02,0x30,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x0E,0xBA,0xAC,0xE0,0x0C,0xE6,0x6D,0xD0,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,
+	0x0A,0x80,0x07,0xA0,
+	// 'I' (0x49)
+	0x02,0x47,0x84,0x20,0x06,0xC9,0x8C,0x60,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x1A,0xB1,0x00,
+	0x07,0xF6,0x5F,0x80,
+	// 'J' (0x4A)
+	0x00,0x03,0x47,0x40,0x00,0x07,0xCA,0xC0,0x00,0x00,0x07,0xA0,0x00,0x00,0x07,0xA0,0x00,0x00,0x07,0xA0,0x00,0x00,0x07,0xA0,0x0B,0x30,0x08,0xA0,0x0B,0xA0,0x1D,0x60,
+	0x02,0xCE,0xE9,0x00,
+	// 'K' (0x4B)
+	0x03,0x20,0x01,0x40,0x09,0x80,0x05,0xC0,0x09,0x80,0x08,0x90,0x09,0x80,0x1E,0x40,0x09,0x81,0xCA,0x00,0x09,0xAE,0x77,0x00,0x09,0xC1,0x6D,0x00,0x09,0x80,0x0D,0x70,
+	0x09,0x80,0x05,0xE1,
+	// 'L' (0x4C)
+	0x02,0x30,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x09,0xB1,0x11,0x10,
+	0x0D,0x5F,0xFF,0xE0,
+	// 'M' (0x4D)
+	0x03,0x50,0x05,0x30,0x0B,0xC4,0x3C,0xB0,0x0B,0xC7,0x7C,0xB0,0x0B,0x7B,0xB7,0xB0,0x0B,0x6C,0xC5,0xB0,0x0B,0x66,0x65,0xB0,0x0B,0x60,0x05,0xB0,0x0B,0x60,0x05,0xB0,
+	0x0B,0x60,0x05,0xB0,
+	// 'N' (0x4E)
+	0x03,0x60,0x02,0x30,0x09,0x83,0x08,0xA0,0x09,0xB9,0x08,0xA0,0x09,0x9D,0x08,0xA0,0x09,0x89,0x58,0xA0,0x09,0x83,0xB8,0xA0,0x09,0x80,0xCA,0xA0,0x09,0x80,0x7C,0xA0,
+	0x09,0x80,0x1C,0xA0,
+	// 'O' (0x4F)
+	0x00,0x15,0x51,0x00,0x02,0xEB,0xBE,0x30,0x0A,0xA0,0x0A,0xA0,0x0E,0x50,0x04,0xE0,0x0F,0x30,0x03,0xF0,0x0F,0x30,0x03,0xF0,0x0D,0x60,0x05,0xD0,0x08,0xC1,0x1C,0x80,
+	0x00,0xAE,0xEB,0x10,
+	// 'P' (0x50)
+	0x02,0x54,0x41,0x00,0x08,0xEC,0xDE,0x40,0x08,0x90,0x07,0xD0,0x08,0x90,0x03,0xF0,0x08,0x90,0x07,0xD0,0x08,0xEA,0xCE,0x40,0x08,0xC6,0x41,0x00,0x08,0x90,0x00,0x00,
+	0x08,0x90,0x00,0x00,
+	// 'Q' (0x51)
+	0x00,0x15,0x51,0x00,0x02,0xEB,0xBE,0x30,0x0A,0xA0,0x0A,0xA0,0x0E,0x50,0x04,0xE0,0x0F,0x30,0x03,0xF0,0x0F,0x30,0x03,0xF0,0x0D,0x60,0x05,0xD0,0x08,0xC1,0x1C,0x80,
+	0x00,0xAB,0xCB,0x10,0x00,0x09,0xA0,0x00,0x00,0x04,0xE6,0x20,
+	// 'R' (0x52)
+	0x03,0x54,0x41,0x00,0x0A,0xFC,0xCE,0x40,0x0A,0x80,0x08,0xB0,0x0A,0x80,0x06,0xC0,0x0A,0xA4,0x5C,0x80,0x0A,0xFC,0x6D,0x00,0x0A,0x80,0x6D,0x00,0x0A,0x80,0x0D,0x60,
+	0x0A,0x80,0x06,0xD0,
+	// 'S' (0x53)
+	0x00,0x15,0x62,0x00,0x02,0xEB,0xAE,0x60,0x06,0xC0,0x02,0x00,0x05,0xD2,0x00,0x00,0x00,0xAE,0xA2,0x00,0x00,0x03,0xAE,0x30,0x00,0x00,0x0A,0x90,0x04,0x20,0x1B,0x80,
+	0x08,0xEE,0xFB,0x10,0x00,0x01,0x00,0x00,
+	// 'T' (0x54)
+	0x04,0x47,0x84,0x40,0x0C,0xC9,0x8C,0xC0,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,0x00,0x08,0x90,0x00,
+	0x00,0x08,0x90,0x00,
+	// 'U' (0x55)
+	0x03,0x20,0x02,0x30,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x0A,0x80,0x07,0xA0,0x09,0x80,0x08,0xA0,0x07,0xC1,0x1C,0x70,
+	0x00,0xAE,0xEA,0x00,
+	// 'V' (0x56)
+	0x04,0x00,0x00,0x41,0x0E,0x30,0x03,0xE0,0x0B,0x70,0x07,0xB0,0x06,0xB0,0x0B,0x70,0x02,0xE0,0x0E,0x20,0x00,0xD4,0x4D,0x00,0x00,0x98,0x89,0x00,0x00,0x4C,0xC5,0x00,
+	0x00,0x0E,0xE1,0x00,
+	// 'W' (0x57)
+	0x14,0x00,0x00,0x41,0x4D,0x00,0x00,0xD4,0x2E,0x03,0x30,0xE3,0x1F,0x1E,0xE1,0xF1,0x0E,0x3A,0xB2,0xE0,0x0C,0x4B,0xB4,0xD0,0x0A,0x79,0x97,0xB0,0x09,0xB8,0x7B,0x90,
+	0x07,0xE6,0x5E,0x80,
+	// 'X' (0x58)
+	0x04,0x10,0x01,0x40,0x09,0xA0,0x0A,0x90,0x01,0xE3,0x3E,0x10,0x00,0x6C,0xB6,0x00,0x00,0x0D,0xC0,0x00,0x00,0x0D,0xD0,0x00,0x00,0x89,0x98,0x00,0x03,0xE1,0x1E,0x30,
+	0x0C,0x70,0x07,0xC0,
+	// 'Y' (0x59)
+	0x14,0x00,0x00,0x41,0x0D,0x50,0x04,0xD0,0x06,0xC0,0x0C,0x60,0x00,0xD4,0x4D,0x00,0x00,0x5C,0xC6,0x00,0x00,0x08,0x70,0x00,0x00,0x0A,0xB0,0x00,0x00,0x08,0x90,0x00,
+	0x00,0x08,0x90,0x00,
+	// 'Z' (0x5A)
+	0x03,0x44,0x44,0x30,0x07,0xCC,0xCA,0xC0,0x00,0x00,0x3E,0x30,0x00,0x00,0xC8,0x00,0x00,0x06,0xC0,0x00,0x00,0x2E,0x30,0x00,0x00,0xB9,0x00,0x00,0x06,0xE2,0x11,0x10,
+	0x0A,0xBF,0xFF,0xB0,
+	// '[' (0x5B)
+	0x29,0x88,0x20,0x4E,0x88,0x20,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0x00,0x00,0x4D,0xCC,
+	0x40,0x14,0x33,0x10,
+	// '\\' (0x5C)
+	0x06,0x10,0x00,0x00,0x0A,0x80,0x00,0x00,0x03,0xE0,0x00,0x00,0x00,0xB6,0x00,0x00,0x00,0x5D,0x00,0x00,0x00,0x0D,0x50,0x00,0x00,0x06,0xC0,0x00,0x00,0x00,0xE3,0x00,
+	0x00,0x00,0x8A,0x00,0x00,0x00,0x1E,0x20,0x00,0x00,0x09,0x80,0x00,0x00,0x00,0x10,
+	// ']' (0x5D)
+	0x02,0x88,0x93,0x02,0x88,0xE5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x00,0x00,0xC5,0x04,0xCC,
+	0xD5,0x01,0x33,0x41,
+	// '^' (0x5E)
+	0x04,0x40,0x2E,0xE2,0x89,0x98,0xE3,0x3E,0x20,0x02,
+	// '_' (0x5F)
+	0x0D,0xFF,0xFF,0xE0,0x01,0x11,0x11,0x10,
+	// '`' (0x60)
+	0x38,0x00,0x1E,0x50,0x07,0xB0,0x00,0xA1,
+	// 'a' (0x61)
+	0x00,0x43,0x10,0x00,0x01,0xCD,0xE7,0x00,0x00,0x00,0x3E,0x10,0x00,0x7A,0xAA,0x30,0x0A,0xA4,0x4C,0x30,0x0D,0x50,0x4E,0x40,0x06,0xED,0xAB,0xF4,0x00,0x01,0x00,0x00,
+	// 'b' (0x62)
+	0x06,0x80,0x00,0x00,0x08,0xA0,0x00,0x00,0x08,0xA2,0x41,0x00,0x08,0xCC,0xBE,0x40,0x08,0xC0,0x08,0xB0,0x08,0xB0,0x05,0xD0,0x08,0xA0,0x07,0xC0,0x08,0xA0,0x3D,0x60,
+	0x0D,0x5E,0xD6,0x00,0x00,0x10,0x00,0x00,
+	// 'c' (0x63)
+	0x00,0x02,0x42,0x00,0x00,0xAE,0xCE,0x80,0x06,0xD1,0x03,0x40,0x09,0x80,0x00,0x00,0x09,0x90,0x00,0x00,0x05,0xE5,0x00,0x00,0x00,0x7E,0xFF,0x80,0x00,0x00,0x11,0x00,
+	// 'd' (0x64)
+	0x00,0x00,0x08,0x60,0x00,0x00,0x0A,0x80,0x00,0x14,0x1A,0x80,0x03,0xEC,0xCC,0x80,0x0B,0x90,0x0C,0x80,0x0D,0x50,0x0B,0x80,0x0D,0x50,0x0C,0x80,0x0A,0xA0,0x2B,0x80,
+	0x02,0xCE,0xC9,0x80,0x00,0x01,0x00,0x00,
+	// 'e' (0x65)
+	0x00,0x03,0x30,0x00,0x01,0xCD,0xDC,0x10,0x08,0xB0,0x0A,0x70,0x0A,0xB7,0x7B,0x90,0x0A,0xC6,0x66,0x40,0x05,0xD3,0x00,0x00,0x00,0x7E,0xEF,0x40,0x00,0x00,0x11,0x00,
+	// 'f' (0x66)
+	0x00,0x01,0x9C,0xD0,0x00,0x0B,0xB3,0x30,0x00,0x0F,0x20,0x00,0x00,0x2F,0x10,0x00,0x1C,0xE2,0xEC,0x80,0x03,0x5B,0x53,0x20,0x00,0x2F,0x10,0x00,0x00,0x2F,0x10,0x00,
+	0x00,0x2F,0x10,0x00,
+	// 'g' (0x67)
+	0x00,0x14,0x11,0x10,0x03,0xEC,0xCC,0x80,0x0B,0x90,0x0C,0x80,0x0D,0x50,0x0B,0x80,0x0D,0x50,0x0C,0x80,0x0A,0xA0,0x2B,0x80,0x02,0xCE,0xCB,0x70,0x00,0x01,0x0D,0x50,
+	0x02,0x56,0xAD,0x10,
+	// 'h' (0x68)
+	0x06,0x80,0x00,0x00,0x07,0xB0,0x00,0x00,0x07,0xB1,0x41,0x00,0x07,0xCC,0xCE,0x20,0x07,0xC0,0x0B,0x70,0x07,0xB0,0x0A,0x80,0x07,0xB0,0x0A,0x80,0x07,0xB0,0x0A,0x80,
+	0x07,0xB0,0x0A,0x80,
+	// 'i' (0x69)
+	0x00,0x04,0xD1,0x00,0x00,0x03,0xA1,0x00,0x00,0x33,0x30,0x00,0x02,0xDE,0x41,0x00,0x00,0x02,0xF0,0x00,0x00,0x02,0xF0,0x00,0x00,0x02,0xF0,0x00,0x00,0x14,0xE2,0x10,
+	0x08,0xFD,0xEE,0xE0,
+	// 'j' (0x6A)
+	0x00,0x00,0xA8,0x00,0x00,0x87,0x00,0x33,0x32,0x00,0xCD,0xEA,0x00,0x00,0x8A,0x00,0x00,0x8A,0x00,0x00,0x9C,0x00,0x00,0x8A,0x00,0x00,0x8A,0x00,0x00,0xA8,0x02,0x59,
+	0xE3,
+	// 'k' (0x6B)
+	0x06,0x80,0x00,0x00,0x08,0xA0,0x00,0x00,0x08,0xA0,0x01,0x20,0x08,0xA0,0x09,0x90,0x08,0xA0,0x1E,0x50,0x08,0xE8,0xCC,0x00,0x08,0xD9,0xC9,0x00,0x08,0xA0,0x3F,0x30,
+	0x08,0xA0,0x09,0xC0,
+	// 'l' (0x6C)
+	0x0B,0xDC,0x10,0x00,0x04,0x5E,0x20,0x00,0x00,0x1F,0x20,0x00,0x00,0x1F,0x20,0x00,0x00,0x1F,0x20,0x00,0x00,0x1F,0x20,0x00,0x00,0x1F,0x20,0x00,0x00,0x0E,0x50,0x10,
+	0x00,0x08,0xFF,0xA0,0x00,0x00,0x01,0x00,
+	// 'm' (0x6D)
+	0x02,0x14,0x04,0x10,0x0C,0xCD,0xDC,0xB0,0x0C,0x77,0x95,0xD0,0x0C,0x67,0x85,0xD0,0x0C,0x67,0x85,0xD0,0x0C,0x67,0x85,0xD0,0x0C,0x67,0x85,0xD0,
+	// 'n' (0x6E)
+	0x01,0x21,0x41,0x00,0x07,0xBD,0xCE,0x20,0x07,0xC0,0x0C,0x70,0x07,0xB0,0x0A,0x80,0x07,0xB0,0x0A,0x80,0x07,0xB0,0x0A,0x80,0x07,0xB0,0x0A,0x80,
+	// 'o' (0x6F)
+	0x00,0x03,0x30,0x00,0x00,0xCD,0xDC,0x10,0x07,0xD0,0x0C,0x70,0x09,0x90,0x08,0xA0,0x09,0x90,0x09,0x90,0x05,0xE2,0x2D,0x60,0x00,0x9E,0xE9,0x00,
+	// 'p' (0x70)
+	0x01,0x21,0x41,0x00,0x07,0xCC,0xBE,0x40,0x07,0xB0,0x08,0xB0,0x07,0xC0,0x04,0xD0,0x07,0xD0,0x05,0xD0,0x07,0xB2,0x0A,0xA0,0x07,0xBC,0xED,0x20,0x07,0xB0,0x10,0x00,
+	0x07,0xB0,0x00,0x00,
+	// 'q' (0x71)
+	0x00,0x14,0x11,0x10,0x03,0xEC,0xCB,0x80,0x0A,0x90,0x0E,0x80,0x0D,0x50,0x0A,0x80,0x0D,0x50,0x0B,0x80,0x0A,0xB0,0x0D,0x80,0x02,0xCE,0xCB,0x80,0x00,0x01,0x0A,0x80,
+	0x00,0x00,0x0A,0x80,
+	// 'r' (0x72)
+	0x02,0x52,0x14,0x10,0x0A,0x7C,0xCC,0xD0,0x00,0x9E,0x00,0xF2,0x00,0x9C,0x00,0x00,0x00,0x99,0x00,0x00,0x01,0xBA,0x10,0x00,0x0F,0x56,0xF1,0x00,
+	// 's' (0x73)
+	0x00,0x03,0x44,0x10,0x02,0xDD,0xBC,0x40,0x06,0xD0,0x00,0x00,0x02,0xDD,0x94,0x00,0x00,0x04,0x8E,0x60,0x01,0x10,0x1C,0x80,0x07,0xFF,0xFB,0x10,0x00,0x11,0x00,0x00,
+	// 't' (0x74)
+	0x00,0x01,0x00,0x00,0x00,0x8A,0x00,0x00,0x03,0xBE,0x33,0x10,0x1D,0x86,0xDD,0x70,0x00,0x8A,0x00,0x00,0x00,0xBE,0x00,0x00,0x00,0x8B,0x00,0x00,0x00,0x6D,0x20,0x00,
+	0x00,0x0B,0xFF,0xA0,0x00,0x00,0x01,0x00,
+	// 'u' (0x75)
+	0x02,0x10,0x02,0x10,0x09,0x80,0x0D,0x50,0x09,0x80,0x0D,0x50,0x09,0x80,0x0D,0x50,0x09,0x80,0x08,0x80,0x08,0xB1,0x4B,0x60,0x02,0xDF,0x9C,0xF3,0x00,0x01,0x00,0x00,
+	// 'v' (0x76)
+	0x03,0x10,0x01,0x30,0x0B,0x70,0x07,0xC0,0x06,0xC0,0x0C,0x60,0x01,0xE2,0x2E,0x10,0x00,0xA7,0x7A,0x00,0x00,0x5C,0xC5,0x00,0x00,0x0E,0xE0,0x00,
+	// 'w' (0x77)
+	0x03,0x03,0x30,0x30,0x0E,0x2E,0xC2,0xE0,0x0D,0x3A,0xA4,0xD0,0x0B,0x4A,0xA5,0xB0,0x0A,0x88,0x98,0x90,0x08,0xB6,0x7B,0x60,0x06,0xE4,0x5E,0x40,
+	// 'x' (0x78)
+	0x02,0x10,0x01,0x20,0x05,0xD1,0x1D,0x50,0x00,0x9A,0xA9,0x00,0x00,0x1B,0xB0,0x00,0x00,0x2C,0xC2,0x00,0x00,0xB8,0x8B,0x00,0x07,0xC0,0x0C,0x80,
+	// 'y' (0x79)
+	0x03,0x00,0x00,0x30,0x0D,0x50,0x07,0xC0,0x07,0xB0,0x0B,0x70,0x01,0xE2,0x0E,0x20,0x00,0xA8,0x4C,0x00,0x00,0x4D,0x98,0x00,0x00,0x0D,0xB3,0x00,0x00,0x06,0xC0,0x00,
+	0x05,0x9E,0x30,0x00,
+	// 'z' (0x7A)
+	0x01,0x33,0x33,0x10,0x07,0xDD,0xD8,0x80,0x00,0x00,0x8C,0x10,0x00,0x06,0xD1,0x00,0x00,0x4E,0x30,0x00,0x04,0xE6,0x11,0x00,0x09,0xAF,0xFF,0x80,
+	// '{' (0x7B)
+	0x00,0x57,0x10,0x08,0xD8,0x10,0x0A,0x80,0x00,0x06,0xC0,0x00,0x04,0xE0,0x00,0xAB,0x50,0x00,0x5A,0xA0,0x00,0x04,0xE0,0x00,0x08,0xA0,0x00,0x0A,0x80,0x00,0x05,0xEC,
+	0x20,0x00,0x13,0x00,
+	// '|' (0x7C)
+	0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x08,0x90,0x07,0x70,
+	// '}' (0x7D)
+	0x01,0x76,0x00,0x01,0x8D,0x90,0x00,0x08,0xA0,0x00,0x0B,0x70,0x00,0x0E,0x50,0x00,0x05,0xBA,0x00,0x09,0xB5,0x00,0x0E,0x40,0x00,0x0A,0x80,0x00,0x08,0xB0,0x02,0xCE,
+	0x50,0x00,0x31,0x00,
+	// '~' (0x7E)
+	0x00,0x31,0x01,0x60,0x09,0xEE,0x87,0xD0,0x0D,0x42,0x9D,0x70,0x02,0x00,0x00,0x00,
+};
+
+static const font_pack_glyph_t __font_cascadia_pack_glyphs[] = {
+	// ' ' (0x20)
+	{.offset = 0, .w = 8, .h = 12, .top = 0, .rows = 0, .left = 0, .bytes = 0, .row_mask = 0x0000},
+	// '!' (0x21)
+	{.offset = 0, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 2, .bytes = 2, .row_mask = 0x01FF},
+	// '"' (0x22)
+	{.offset = 18, .w = 8, .h = 12, .top = 1, .rows = 5, .left = 2, .bytes = 2, .row_mask = 0x001F},
+	// '#' (0x23)
+	{.offset = 28, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '$' (0x24)
+	{.offset = 64, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 4, .row_mask = 0x0FFF},
+	// '%' (0x25)
+	{.offset = 112, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// '&' (0x26)
+	{.offset = 152, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// "'" (0x27)
+	{.offset = 192, .w = 8, .h = 12, .top = 1, .rows = 5, .left = 2, .bytes = 2, .row_mask = 0x001F},
+	// '(' (0x28)
+	{.offset = 202, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 2, .bytes = 3, .row_mask = 0x0FFF},
+	// ')' (0x29)
+	{.offset = 238, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 3, .row_mask = 0x0FFF},
+	// '*' (0x2A)
+	{.offset = 274, .w = 8, .h = 12, .top = 3, .rows = 6, .left = 0, .bytes = 4, .row_mask = 0x003F},
+	// '+' (0x2B)
+	{.offset = 298, .w = 8, .h = 12, .top = 2, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// ',' (0x2C)
+	{.offset = 326, .w = 8, .h = 12, .top = 8, .rows = 4, .left = 2, .bytes = 2, .row_mask = 0x000F},
+	// '-' (0x2D)
+	{.offset = 334, .w = 8, .h = 12, .top = 5, .rows = 2, .left = 0, .bytes = 4, .row_mask = 0x0003},
+	// '.' (0x2E)
+	{.offset = 342, .w = 8, .h = 12, .top = 8, .rows = 2, .left = 2, .bytes = 2, .row_mask = 0x0003},
+	// '/' (0x2F)
+	{.offset = 346, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 4, .row_mask = 0x0FFF},
+	// '0' (0x30)
+	{.offset = 394, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '1' (0x31)
+	{.offset = 430, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '2' (0x32)
+	{.offset = 466, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '3' (0x33)
+	{.offset = 502, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// '4' (0x34)
+	{.offset = 542, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '5' (0x35)
+	{.offset = 578, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// '6' (0x36)
+	{.offset = 618, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '7' (0x37)
+	{.offset = 654, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '8' (0x38)
+	{.offset = 690, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '9' (0x39)
+	{.offset = 726, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// ':' (0x3A)
+	{.offset = 762, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 2, .bytes = 2, .row_mask = 0x0067},
+	// ';' (0x3B)
+	{.offset = 772, .w = 8, .h = 12, .top = 3, .rows = 9, .left = 2, .bytes = 2, .row_mask = 0x01E7},
+	// '<' (0x3C)
+	{.offset = 786, .w = 8, .h = 12, .top = 3, .rows = 6, .left = 0, .bytes = 4, .row_mask = 0x003F},
+	// '=' (0x3D)
+	{.offset = 810, .w = 8, .h = 12, .top = 3, .rows = 5, .left = 0, .bytes = 4, .row_mask = 0x001B},
+	// '>' (0x3E)
+	{.offset = 826, .w = 8, .h = 12, .top = 3, .rows = 6, .left = 0, .bytes = 4, .row_mask = 0x003F},
+	// '?' (0x3F)
+	{.offset = 850, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '@' (0x40)
+	{.offset = 886, .w = 8, .h = 12, .top = 1, .rows = 11, .left = 0, .bytes = 4, .row_mask = 0x07FF},
+	// 'A' (0x41)
+	{.offset = 930, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'B' (0x42)
+	{.offset = 966, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'C' (0x43)
+	{.offset = 1002, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'D' (0x44)
+	{.offset = 1042, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'E' (0x45)
+	{.offset = 1078, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'F' (0x46)
+	{.offset = 1114, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'G' (0x47)
+	{.offset = 1150, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'H' (0x48)
+	{.offset = 1190, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'I' (0x49)
+	{.offset = 1226, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'J' (0x4A)
+	{.offset = 1262, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'K' (0x4B)
+	{.offset = 1298, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'L' (0x4C)
+	{.offset = 1334, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'M' (0x4D)
+	{.offset = 1370, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'N' (0x4E)
+	{.offset = 1406, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'O' (0x4F)
+	{.offset = 1442, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'P' (0x50)
+	{.offset = 1478, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'Q' (0x51)
+	{.offset = 1514, .w = 8, .h = 12, .top = 1, .rows = 11, .left = 0, .bytes = 4, .row_mask = 0x07FF},
+	// 'R' (0x52)
+	{.offset = 1558, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'S' (0x53)
+	{.offset = 1594, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'T' (0x54)
+	{.offset = 1634, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'U' (0x55)
+	{.offset = 1670, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'V' (0x56)
+	{.offset = 1706, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'W' (0x57)
+	{.offset = 1742, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'X' (0x58)
+	{.offset = 1778, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'Y' (0x59)
+	{.offset = 1814, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'Z' (0x5A)
+	{.offset = 1850, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// '[' (0x5B)
+	{.offset = 1886, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 2, .bytes = 3, .row_mask = 0x0FFF},
+	// '\\' (0x5C)
+	{.offset = 1922, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 4, .row_mask = 0x0FFF},
+	// ']' (0x5D)
+	{.offset = 1970, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 3, .row_mask = 0x0FFF},
+	// '^' (0x5E)
+	{.offset = 2006, .w = 8, .h = 12, .top = 1, .rows = 5, .left = 2, .bytes = 2, .row_mask = 0x001F},
+	// '_' (0x5F)
+	{.offset = 2016, .w = 8, .h = 12, .top = 10, .rows = 2, .left = 0, .bytes = 4, .row_mask = 0x0003},
+	// '`' (0x60)
+	{.offset = 2024, .w = 8, .h = 12, .top = 0, .rows = 4, .left = 2, .bytes = 2, .row_mask = 0x000F},
+	// 'a' (0x61)
+	{.offset = 2032, .w = 8, .h = 12, .top = 3, .rows = 8, .left = 0, .bytes = 4, .row_mask = 0x00FF},
+	// 'b' (0x62)
+	{.offset = 2064, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'c' (0x63)
+	{.offset = 2104, .w = 8, .h = 12, .top = 3, .rows = 8, .left = 0, .bytes = 4, .row_mask = 0x00FF},
+	// 'd' (0x64)
+	{.offset = 2136, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'e' (0x65)
+	{.offset = 2176, .w = 8, .h = 12, .top = 3, .rows = 8, .left = 0, .bytes = 4, .row_mask = 0x00FF},
+	// 'f' (0x66)
+	{.offset = 2208, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'g' (0x67)
+	{.offset = 2244, .w = 8, .h = 12, .top = 3, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'h' (0x68)
+	{.offset = 2280, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'i' (0x69)
+	{.offset = 2316, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'j' (0x6A)
+	{.offset = 2352, .w = 8, .h = 12, .top = 1, .rows = 11, .left = 0, .bytes = 3, .row_mask = 0x07FF},
+	// 'k' (0x6B)
+	{.offset = 2385, .w = 8, .h = 12, .top = 1, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'l' (0x6C)
+	{.offset = 2421, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'm' (0x6D)
+	{.offset = 2461, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'n' (0x6E)
+	{.offset = 2489, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'o' (0x6F)
+	{.offset = 2517, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'p' (0x70)
+	{.offset = 2545, .w = 8, .h = 12, .top = 3, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'q' (0x71)
+	{.offset = 2581, .w = 8, .h = 12, .top = 3, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'r' (0x72)
+	{.offset = 2617, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 's' (0x73)
+	{.offset = 2645, .w = 8, .h = 12, .top = 3, .rows = 8, .left = 0, .bytes = 4, .row_mask = 0x00FF},
+	// 't' (0x74)
+	{.offset = 2677, .w = 8, .h = 12, .top = 1, .rows = 10, .left = 0, .bytes = 4, .row_mask = 0x03FF},
+	// 'u' (0x75)
+	{.offset = 2717, .w = 8, .h = 12, .top = 3, .rows = 8, .left = 0, .bytes = 4, .row_mask = 0x00FF},
+	// 'v' (0x76)
+	{.offset = 2749, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'w' (0x77)
+	{.offset = 2777, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'x' (0x78)
+	{.offset = 2805, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// 'y' (0x79)
+	{.offset = 2833, .w = 8, .h = 12, .top = 3, .rows = 9, .left = 0, .bytes = 4, .row_mask = 0x01FF},
+	// 'z' (0x7A)
+	{.offset = 2869, .w = 8, .h = 12, .top = 3, .rows = 7, .left = 0, .bytes = 4, .row_mask = 0x007F},
+	// '{' (0x7B)
+	{.offset = 2897, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 2, .bytes = 3, .row_mask = 0x0FFF},
+	// '|' (0x7C)
+	{.offset = 2933, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 2, .bytes = 2, .row_mask = 0x0FFF},
+	// '}' (0x7D)
+	{.offset = 2957, .w = 8, .h = 12, .top = 0, .rows = 12, .left = 0, .bytes = 3, .row_mask = 0x0FFF},
+	// '~' (0x7E)
+	{.offset = 2993, .w = 8, .h = 12, .top = 4, .rows = 4, .left = 0, .bytes = 4, .row_mask = 0x000F},
+};
+
+const font_pack_t cascadia_pack = {
+	.data = __font_cascadia_pack_data,
+	.glyphs = __font_cascadia_pack_glyphs,
+	.first = 32,
+	.last = 126,
+};
@@ -0,0 +1,29 @@
+#include "font_pack.h"
+
+#include <stddef.h>
+
+const font_pack_glyph_t *font_pack_glyph(const font_pack_t *font, char c)
+{
+    unsigned char i = c;
+
+    if (i < font->first || i > font->last)
+        i = (font->first <= ' ' && font->last >= ' ') ? ' ' : font->first;
+
+    return &font->glyphs[i - font->first];
+}
+
+const uint8_t *font_pack_row(const font_pack_t *font, const font_pack_glyph_t *g, int row)
+{
+    uint16_t bit;
+
+    row -= g->top;
+    if (row < 0 || row >= g->rows)
+        return NULL;
+
+    bit = 1 << row;
+    if ((g->row_mask & bit) == 0)
+        return NULL;
+
+    // stored rows before this one
+    return &font->data[g->offset + __builtin_popcount(g->row_mask & (bit - 1)) * g->bytes];
+}
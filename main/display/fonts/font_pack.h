@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// glyph cropped to the bounding box of its pixels; of the box rows only the
+// ones marked in row_mask are stored, the others are blank
+typedef struct {
+    uint16_t offset;    // of the first stored row in the font data
+    uint8_t w;          // cell size in pixels, w is also the advance
+    uint8_t h;
+    uint8_t top;        // first row of the box
+    uint8_t rows;       // rows of the box, 16 at most
+    uint8_t left;       // first column of the box, always even
+    uint8_t bytes;      // stored bytes per row, two 4bpp pixels each
+    uint16_t row_mask;  // bit n is set if the box row n is stored
+} font_pack_glyph_t;
+
+// font generated by tools/fontpack.py
+typedef struct {
+    const uint8_t *data;
+    const font_pack_glyph_t *glyphs;
+    uint8_t first;
+    uint8_t last;
+} font_pack_t;
+
+// glyph of a char, the space for chars out of the font range
+const font_pack_glyph_t *font_pack_glyph(const font_pack_t *font, char c);
+// stored pixels of a cell row starting at the box left column, NULL if the row is blank
+const uint8_t *font_pack_row(const font_pack_t *font, const font_pack_glyph_t *g, int row);
@@ -0,0 +1,113 @@
+#include "panel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+
+// the commands and the serial interface are from the SSD1322 datasheet:
+// Set Column Address and Set Row Address take the start and the end address
+// as their data bytes, Write RAM Command takes none and the pixels follow it
+#define CMD_SET_COLUMN      (0x15)
+#define CMD_SET_ROW         (0x75)
+#define CMD_WRITE_RAM       (0x5C)
+// 4-wire SPI samples D/C# on every eighth clock, low is a command
+#define DC_COMMAND          (0)
+#define DC_DATA             (1)
+// shortest serial clock cycle of the 4-wire SPI is 100 ns
+#define CLOCK_SPEED_HZ      (10 * 1000 * 1000)
+
+panel_t *panel_init(spi_host_device_t host, panel_pinmap_t pinmap, uint8_t column_offset)
+{
+    panel_t *panel = malloc(sizeof(panel_t));
+    if (panel == NULL)
+    {
+        return NULL;
+    }
+
+    memset(panel, 0, sizeof(panel_t));
+    panel->pinmap = pinmap;
+    panel->column_offset = column_offset;
+
+    spi_device_interface_config_t dev_cfg = {
+        .mode = 0,
+        .clock_speed_hz = CLOCK_SPEED_HZ,
+        .spics_io_num = pinmap.cs,
+        .queue_size = 1,
+    };
+
+    if (spi_bus_add_device(host, &dev_cfg, &panel->spi_dev) != ESP_OK)
+    {
+        free(panel);
+        return NULL;
+    }
+
+    gpio_set_direction(pinmap.dc, GPIO_MODE_OUTPUT);
+
+    return panel;
+}
+
+void panel_deinit(panel_t *panel)
+{
+    panel_wait(panel);
+    spi_bus_remove_device(panel->spi_dev);
+    free(panel);
+}
+
+void panel_wait(panel_t *panel)
+{
+    spi_transaction_t *t;
+
+    if (!panel->pending)
+    {
+        return;
+    }
+
+    spi_device_get_trans_result(panel->spi_dev, &t, portMAX_DELAY);
+    panel->pending = false;
+}
+
+// D/C is a plain GPIO, so it may change only while nothing is in transfer
+static void write_command(panel_t *panel, uint8_t cmd, const uint8_t *args, size_t len)
+{
+    spi_transaction_t t = {
+        .flags = SPI_TRANS_USE_TXDATA,
+        .length = 8,
+        .tx_data = {cmd},
+    };
+
+    panel_wait(panel);
+
+    gpio_set_level(panel->pinmap.dc, DC_COMMAND);
+    spi_device_polling_transmit(panel->spi_dev, &t);
+
+    if (len == 0)
+    {
+        return;
+    }
+
+    t.length = len * 8;
+    memcpy(t.tx_data, args, len);
+    gpio_set_level(panel->pinmap.dc, DC_DATA);
+    spi_device_polling_transmit(panel->spi_dev, &t);
+}
+
+uint32_t panel_write_window(panel_t *panel, int col0, int col1, int row0, int row1, const uint8_t *data, size_t len)
+{
+    uint8_t col[2] = {panel->column_offset + col0, panel->column_offset + col1};
+    uint8_t row[2] = {row0, row1};
+
+    write_command(panel, CMD_SET_COLUMN, col, sizeof(col));
+    write_command(panel, CMD_SET_ROW, row, sizeof(row));
+    write_command(panel, CMD_WRITE_RAM, NULL, 0);
+
+    panel->trans = (spi_transaction_t){
+        .length = len * 8,
+        .tx_buffer = data,
+    };
+
+    gpio_set_level(panel->pinmap.dc, DC_DATA);
+    panel->pending = spi_device_queue_trans(panel->spi_dev, &panel->trans, portMAX_DELAY) == ESP_OK;
+
+    return 3 + sizeof(col) + sizeof(row) + len;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <driver/spi_master.h>
+#include <driver/gpio.h>
+
+typedef struct
+{
+    gpio_num_t dc;
+    gpio_num_t cs;
+} panel_pinmap_t;
+
+// window writes to the SSD1322 RAM over a SPI device of its own, the ssd1322 driver
+// only resets and sets up the controller and sends the boot logo; once this device
+// is added the chip select belongs to it and the driver must not transfer anymore
+typedef struct
+{
+    spi_device_handle_t spi_dev;
+    panel_pinmap_t pinmap;
+    uint8_t column_offset;
+
+    spi_transaction_t trans;
+    bool pending;
+} panel_t;
+
+// column_offset is the RAM column of the first visible one, it depends on the glass
+panel_t *panel_init(spi_host_device_t host, panel_pinmap_t pinmap, uint8_t column_offset);
+void panel_deinit(panel_t *panel);
+
+// write the pixels of columns col0..col1 (4 pixels each) and rows row0..row1,
+// the commands are sent right away and the data is queued from the DMA capable
+// buffer, which must stay untouched until panel_wait; returns the bytes sent
+uint32_t panel_write_window(panel_t *panel, int col0, int col1, int row0, int row1, const uint8_t *data, size_t len);
+// block until the last queued data is on the panel
+void panel_wait(panel_t *panel);
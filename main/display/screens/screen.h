@@ -13,7 +13,11 @@ typedef enum {
     SCREEN_CALCULATION,
     SCREEN_UPDATE,
     SCREEN_TEST,
+    SCREEN_HEXVIEW,
 } ui_screen_num_t;
 
 extern const ui_screen_t *const ui_screens[];
 extern const int ui_screens_count;
+
+// show a file from the SD card environment directory in the hex viewer
+void hexview_open_file(const char *name);
@@ -12,11 +12,12 @@
 #include <keyboard.h>
 #include <sensors.h>
 #include <calc.h>
+#include <ui.h>
 
 #include "../ssd1322/ssd1322.h"
-#include "../ssd1322/ssd1322_font.h"
 #include "../ssd1322/ssd1322_bitmap.h"
-#include "../fonts/cascadia_font.h"
+#include "../fonts/cascadia_pack.h"
+#include "../text/text.h"
 #include "../bitmaps/icons/charge_bmp.h"
 #include "../bitmaps/icons/battery_bmp.h"
 #include "../bitmaps/icons/enter_pressed_bmp.h"
@@ -26,6 +27,9 @@
 #define OUTPUT_BUFFER_SCROLL_STEP (4)
 #define INPUT_HISTORY_DEPTH (16)
 #define INPUT_BUFFER_LEN (1024)
+#define PREVIEW_LEN (26)
+#define SCRIPT_PREFIX '@'
+#define HEXVIEW_PREFIX '%'
 
 typedef struct {
     char str[INPUT_BUFFER_LEN+1];
@@ -37,11 +41,15 @@ extern ssd1322_t *ui_display;
 
 static char text_buffer[INPUT_BUFFER_LEN*2];
 
+static SemaphoreHandle_t output_lock;
 static char output_buffer[OUTPUT_BUFFER_LEN+1] = {'\0'};
 static int output_buffer_len = 0;
 static int output_buffer_lines_cnt = 0;
 static char *output_line_begin = &output_buffer[0];
 static int output_buffer_scroll = 0;
+static bool output_dirty = false;
+
+static char preview_str[PREVIEW_LEN+1] = {'\0'};
 
 static ui_input_str_t input_buffer[INPUT_HISTORY_DEPTH+1];
 static int input_history_len = 1;
@@ -56,22 +64,39 @@ static void navigation_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bo
 static void backspace_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
 static void enter_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
 static void enter_key_released_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+static void calc_event_callback(calc_ticket_t ticket, calc_event_t event, const char *str);
+static void calc_preview_callback(const char *result);
 
 static float last_bat_level;
 static int last_bat_is_charge;
 static void battery_change_callback(sens_t sensor, float value);
 
 static void output_string(const char *str);
+static void output_begin(void);
+static void output_write(const char *str, int str_len);
+static void output_end(void);
+static void output_drain(void);
+
+static const calc_writer_t output_writer = {
+    .begin = output_begin,
+    .write = output_write,
+    .end = output_end,
+};
 static void input_take_history(void);
 static void input_push_history(void);
+static void input_changed(void);
 
 static void proccess_input_navigation(kbrd_key_t k, kbrd_key_state_t s);
 static void proccess_output_navigation(kbrd_key_t k, kbrd_key_state_t s);
 
 static void draw_battery_level(void);
 static void draw_output_scrollbar(void);
+static void draw_preview(void);
+static void draw_script_progress(void);
+static void dim_rect(int x, int y, int w, int h);
 
 static TaskHandle_t bg_task_handle;
+static volatile bool screen_shown;
 static void bg_task(void *arg);
 
 static bool init(void);
@@ -88,10 +113,15 @@ const ui_screen_t calc_screen = {
 
 static bool init(void)
 {
-    if (!xTaskCreate(bg_task, "disp-bg", 1024, NULL, 0, &bg_task_handle))
+    output_lock = xSemaphoreCreateMutex();
+    if (output_lock == NULL)
+        return false;
+
+    calc_set_writer(&output_writer);
+
+    if (!xTaskCreate(bg_task, "disp-bg", 2048, NULL, 0, &bg_task_handle))
         return false;
-    
-    vTaskSuspend(bg_task_handle);
+
     return true;
 }
 
@@ -119,7 +149,7 @@ static void open(void)
     last_bat_level = sensors_get_value(SENS_BAT_LEVEL);
     last_bat_is_charge = sensors_get_value(SENS_BAT_CHARGING);
 
-    vTaskResume(bg_task_handle);
+    screen_shown = true;
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -129,15 +159,19 @@ static void draw(void)
     static int out_y = 0;
     static char *out_nl = NULL;
 
+    // take everything printed since the last frame
+    output_drain();
+
     // clear output field
     ssd1322_draw_rect_filled(ui_display, 0, 0, ui_display->res_x, ui_display->res_y - 15, 0);
 
     // draw output
+    xSemaphoreTake(output_lock, portMAX_DELAY);
     out_y = 4;
     out_nl = output_line_begin;
     while (out_y - output_buffer_scroll < ui_display->res_y - 14)
     {
-        ssd1322_draw_string(ui_display, 4, out_y - output_buffer_scroll, out_nl, cascadia_font);
+        text_draw_string(ui_display, 4, out_y - output_buffer_scroll, out_nl, &cascadia_pack);
 
         out_nl = strchr(out_nl, '\n');
         if (out_nl == NULL)
@@ -147,20 +181,23 @@ static void draw(void)
 
         out_y += 12;
     }
+    xSemaphoreGive(output_lock);
 
     // draw ui
+    draw_preview();
     draw_output_scrollbar();
     draw_battery_level();
 
     // clear input field
     ssd1322_draw_rect_filled(ui_display, 0, ui_display->res_y - 14, ui_display->res_x, 14, 0);
     ssd1322_draw_hline(ui_display, 0, ui_display->res_x, ui_display->res_y - 15, 8);
+    draw_script_progress();
 
     cursor_overflow = input_cursor - (ui_display->res_x - 40) / 8;
     if (cursor_overflow > 0)
     {
         // draw input string
-        ssd1322_draw_string(ui_display, 4, ui_display->res_y - 14, &input_buffer[input_history_pos].str[cursor_overflow], cascadia_font);
+        text_draw_string(ui_display, 4, ui_display->res_y - 14, &input_buffer[input_history_pos].str[cursor_overflow], &cascadia_pack);
         // draw cursor underline
         ssd1322_draw_hline(ui_display, 4 + (input_cursor - cursor_overflow) * 8, 12 + (input_cursor - cursor_overflow) * 8, ui_display->res_y - 1, 3);
         // draw fade effect
@@ -173,7 +210,7 @@ static void draw(void)
     else
     {
         // draw input string
-        ssd1322_draw_string(ui_display, 4, ui_display->res_y - 14, input_buffer[input_history_pos].str, cascadia_font);
+        text_draw_string(ui_display, 4, ui_display->res_y - 14, input_buffer[input_history_pos].str, &cascadia_pack);
         // draw cursor underline
         ssd1322_draw_hline(ui_display, 4 + input_cursor * 8, 12 + input_cursor * 8, ui_display->res_y - 1, 3);
     }
@@ -201,7 +238,7 @@ static void close(void)
     sensors_register_callback(SENS_BAT_LEVEL, NULL);
     sensors_register_callback(SENS_BAT_CHARGING, NULL);
 
-    vTaskSuspend(bg_task_handle);
+    screen_shown = false;
 }
 
 static void register_text_key_callbacks(kbrd_key_state_t state, kbrd_callback_t callback)
@@ -228,6 +265,13 @@ static void register_navigation_key_callbacks(kbrd_key_state_t state, kbrd_callb
 
 static void text_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed)
 {
+    if (keyboard_is_key_pressed(KEY_CTRL))
+    {
+        if (k == KEY_C && s == KEY_PRESSED)
+            calc_cancel();
+        return;
+    }
+
     if (input_cursor >= INPUT_BUFFER_LEN-1) return;
 
     if (input_history_pos > 0)
@@ -242,6 +286,7 @@ static void text_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pre
     ++input_buffer[0].len;
     ++input_cursor;
 
+    input_changed();
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -274,6 +319,7 @@ static void backspace_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, boo
     --input_buffer[0].len;
     --input_cursor;
 
+    input_changed();
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -287,12 +333,60 @@ static void enter_key_released_callback(kbrd_key_t k, kbrd_key_state_t s, bool p
     if (input_history_pos > 0)
         input_take_history();
 
-    sprintf(text_buffer, ">: %s\n", input_buffer[0].str);
-    output_string(text_buffer);
-    calc_expression(input_buffer[0].str);
-    output_string(calc_await_expression());
+    if (input_buffer[0].str[0] == SCRIPT_PREFIX)
+    {
+        // run a script from the SD card
+        sprintf(text_buffer, ">: %s\n", input_buffer[0].str);
+        output_string(text_buffer);
+        if (calc_run_script(&input_buffer[0].str[1], calc_event_callback) == 0)
+            output_string("<: error: calculator is busy\n");
+    }
+    else if (input_buffer[0].str[0] == HEXVIEW_PREFIX)
+    {
+        // show a file from the SD card in the hex viewer
+        sprintf(text_buffer, ">: %s\n", input_buffer[0].str);
+        output_string(text_buffer);
+        input_push_history();
+        input_changed();
+        hexview_open_file(&input_buffer[1].str[1]);
+        return;
+    }
+    else if (calc_submit(input_buffer[0].str, calc_event_callback) == 0)
+    {
+        sprintf(text_buffer, ">: %s\n<: error: calculator is busy\n", input_buffer[0].str);
+        output_string(text_buffer);
+    }
 
     input_push_history();
+    calc_preview_callback(NULL);
+    input_changed();
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void calc_event_callback(calc_ticket_t ticket, calc_event_t event, const char *str)
+{
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void calc_preview_callback(const char *result)
+{
+    int len = 0;
+
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+    if (result != NULL)
+    {
+        // show only the first line of the result
+        if (strncmp(result, "<: ", 3) == 0)
+            result += 3;
+        while (len < PREVIEW_LEN && result[len] != '\0' && result[len] != '\n')
+        {
+            preview_str[len] = result[len];
+            ++len;
+        }
+    }
+    preview_str[len] = '\0';
+    xSemaphoreGive(output_lock);
+
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -310,43 +404,72 @@ static void output_string(const char *str)
 {
     if (str == NULL) return;
 
-    int lines_cnt = 0;
-    const char *s;
+    output_begin();
+    output_write(str, strlen(str));
+    output_end();
+}
+
+static void output_begin(void)
+{
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+}
 
+static void output_write(const char *str, int str_len)
+{
     // count new line symbols
-    for (s = str; *s != '\0'; ++s)
+    for (int i = 0; i < str_len; ++i)
     {
-        if (*s == '\n')
-            ++lines_cnt;
+        if (str[i] == '\n')
+            ++output_buffer_lines_cnt;
     }
-    output_buffer_lines_cnt += lines_cnt;
 
-    int str_len = s - str;
+    // keep only the tail of a string longer than the whole buffer
+    if (str_len > OUTPUT_BUFFER_LEN)
+    {
+        str += str_len - OUTPUT_BUFFER_LEN;
+        str_len = OUTPUT_BUFFER_LEN;
+    }
 
     // free space for new string
     if (output_buffer_len + str_len > OUTPUT_BUFFER_LEN)
     {
-        int dif_len = (output_buffer_len + str_len + 1) - OUTPUT_BUFFER_LEN;
+        int dif_len = (output_buffer_len + str_len) - OUTPUT_BUFFER_LEN;
         memmove(output_buffer, &output_buffer[dif_len], output_buffer_len - dif_len);
         output_buffer_len -= dif_len;
     }
 
     memcpy(&output_buffer[output_buffer_len], str, str_len);
     output_buffer_len += str_len;
-
-    // insert last new line symbol if missed
-    // if (str[str_len] != '\n')
-    // {
-    //     output_buffer[output_buffer_len++] = '\n';
-    //     output_buffer_lines_cnt += 1;
-    // }
-
     output_buffer[output_buffer_len] = '\0';
+    output_dirty = true;
+}
 
+static void output_end(void)
+{
     // autoscroll
-    output_buffer_scroll = 12 * output_buffer_lines_cnt - (ui_display->res_y - 20);
-    if (output_buffer_scroll < 0)
-        output_buffer_scroll = 0;
+    if (output_dirty)
+    {
+        output_buffer_scroll = 12 * output_buffer_lines_cnt - (ui_display->res_y - 20);
+        if (output_buffer_scroll < 0)
+            output_buffer_scroll = 0;
+        output_dirty = false;
+    }
+
+    xSemaphoreGive(output_lock);
+}
+
+static void output_drain(void)
+{
+    const char *str;
+    int len;
+
+    output_begin();
+    while ((len = calc_read_output(&str)) > 0)
+    {
+        output_write(str, len);
+        calc_done_output(len);
+    }
+    output_end();
 }
 
 static void input_take_history(void)
@@ -370,6 +493,11 @@ static void input_push_history(void)
     memset(input_buffer[0].str, 0, INPUT_BUFFER_LEN);
 }
 
+static void input_changed(void)
+{
+    calc_preview(input_buffer[input_history_pos].str, calc_preview_callback);
+}
+
 static void proccess_input_navigation(kbrd_key_t k, kbrd_key_state_t s)
 {
     switch (k)
@@ -403,6 +531,7 @@ history_move:
     else if (input_history_pos > input_history_len-1)
         input_history_pos = input_history_len-1;
     input_cursor = input_buffer[input_history_pos].len;
+    input_changed();
     return;
 }
 
@@ -451,6 +580,17 @@ static void draw_battery_level(void)
     ssd1322_draw_bitmap(ui_display, ui_display->res_x - 16, 2, battery_icons[bat_id]);
 }
 
+static void draw_script_progress(void)
+{
+    int progress = calc_script_progress();
+
+    if (progress < 0)
+        return;
+
+    // fill the input separator line as the script goes
+    ssd1322_draw_hline(ui_display, 0, ui_display->res_x * progress / 100, ui_display->res_y - 15, 15);
+}
+
 static void draw_output_scrollbar(void)
 {
     static float thumb_size;
@@ -491,18 +631,49 @@ static void draw_output_scrollbar(void)
         ssd1322_draw_hline(ui_display, ui_display->res_x - 2, ui_display->res_x, 2 + thumb_size, 2 + roundf(6 * thumb_bottom_blend));
 }
 
-static void bg_task(void *arg)
+static void draw_preview(void)
+{
+    int len, x, y;
+
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+    len = strlen(preview_str);
+    if (len > 0)
+    {
+        // right aligned over the last output line
+        x = ui_display->res_x - 8 - len * 8;
+        y = ui_display->res_y - 28;
+        ssd1322_draw_rect_filled(ui_display, x - 4, y - 1, len * 8 + 6, 13, 0);
+        text_draw_string(ui_display, x, y, preview_str, &cascadia_pack);
+        dim_rect(x, y, len * 8, 12);
+    }
+    xSemaphoreGive(output_lock);
+}
+
+static void dim_rect(int x, int y, int w, int h)
 {
-    const char *out_str;
+    // two 4bpp pixels per byte, x and w are even
+    uint8_t *row = &ui_display->framebuffer[y * ui_display->res_x / 2 + x / 2];
 
+    for (int j = 0; j < h; ++j)
+    {
+        for (int i = 0; i < w / 2; ++i)
+            row[i] = (row[i] >> 1) & 0x77;
+        row += ui_display->res_x / 2;
+    }
+}
+
+static void bg_task(void *arg)
+{
     while(1)
     {
-        out_str = calc_await_output(150);
-        if (out_str)
-        {
-            output_string(out_str);
-            calc_done_output();
+        if (!calc_await_output(150))
+            continue;
+
+        // the ring itself is drained by the next frame, while another screen
+        // is shown it is drained here, so a running script is never blocked
+        if (screen_shown)
             xSemaphoreGive(ui_refresh_sem);
-        }
+        else
+            output_drain();
     }
 }
@@ -0,0 +1,487 @@
+#include "screen.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#include <ui.h>
+#include <keyboard.h>
+#include <sdcard.h>
+
+#include "../ssd1322/ssd1322.h"
+#include "../fonts/cascadia_pack.h"
+#include "../text/text.h"
+
+// 32 columns of the 8 px font fit only 8 bytes per row next to the ASCII column
+#define ROW_BYTES       (8)
+#define ROWS            (4)
+#define VIEW_BYTES      (ROW_BYTES * ROWS)
+#define PAGE_LEN        (2048)
+#define CACHE_PAGES     (6)
+#define GOTO_LEN        (8)
+#define NO_PAGE         (UINT32_MAX)
+
+#define HEX_X           (40)
+#define HEX_STEP        (18)
+#define ASCII_X         (188)
+
+typedef struct {
+    uint32_t page;
+    uint32_t used;
+    int len;
+    uint8_t *data;
+} page_slot_t;
+
+extern SemaphoreHandle_t ui_refresh_sem;
+extern ssd1322_t *ui_display;
+
+static char file_name[SDCARD_MAX_FILE_NAME+1];
+static int64_t file_size;
+static const char *error_msg;
+
+static uint32_t view_offset;
+static int scroll_dir;
+static char goto_str[GOTO_LEN+1];
+static int goto_len;
+
+// file_lock serializes the reads of the one handle of the viewed file and is
+// taken before cache_lock, which is held only to look up and publish the pages
+static SemaphoreHandle_t file_lock;
+static sdcard_file_t file;
+static SemaphoreHandle_t cache_lock;
+static uint8_t *cache_mem;
+static page_slot_t cache[CACHE_PAGES];
+static uint32_t cache_clock;
+
+static TaskHandle_t prefetch_task_handle;
+static volatile uint32_t prefetch_page;
+static void prefetch_task(void *arg);
+
+static page_slot_t *cache_find(uint32_t page);
+static bool cache_load(uint32_t page);
+static int read_bytes(uint32_t offset, uint8_t *buf, int len);
+static void request_prefetch(void);
+static void move_to(int64_t offset);
+static void scroll(int delta);
+
+static void navigation_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+static void text_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+static void backspace_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+static void enter_key_released_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+static void register_key_callbacks(bool enable);
+
+static void draw_rows(void);
+static void draw_status(void);
+
+static bool init(void);
+static void open(void);
+static void draw(void);
+static void close(void);
+
+const ui_screen_t hexview_screen = {
+    .init = init,
+    .open = open,
+    .draw = draw,
+    .close = close
+};
+
+void hexview_open_file(const char *name)
+{
+    snprintf(file_name, sizeof(file_name), "%s", name);
+    ui_change_screen(SCREEN_HEXVIEW);
+}
+
+static bool init(void)
+{
+    file_lock = xSemaphoreCreateMutex();
+    cache_lock = xSemaphoreCreateMutex();
+    if (file_lock == NULL || cache_lock == NULL)
+        return false;
+
+    if (!xTaskCreate(prefetch_task, "hex-prefetch", 4096, NULL, 0, &prefetch_task_handle))
+        return false;
+
+    return true;
+}
+
+static void open(void)
+{
+    view_offset = 0;
+    scroll_dir = 1;
+    goto_len = 0;
+    goto_str[0] = '\0';
+    error_msg = NULL;
+    file_size = 0;
+
+    if (!sdcard_is_mounted() && sdcard_mount() != SD_OK)
+    {
+        error_msg = "no SD card";
+    }
+    else if ((file_size = sdcard_file_size_raw(file_name)) < 0 ||
+             sdcard_file_open(&file, file_name, "r") != SD_OK)
+    {
+        error_msg = "no such file";
+        file_size = 0;
+    }
+
+    xSemaphoreTake(cache_lock, portMAX_DELAY);
+    for (int i = 0; i < CACHE_PAGES; ++i)
+        cache[i].page = NO_PAGE;
+    if (error_msg == NULL)
+    {
+        cache_mem = malloc(PAGE_LEN * CACHE_PAGES);
+        if (cache_mem == NULL)
+        {
+            error_msg = "out of memory";
+            sdcard_file_close(file);
+            file = NULL;
+        }
+        for (int i = 0; i < CACHE_PAGES && cache_mem != NULL; ++i)
+            cache[i].data = &cache_mem[i * PAGE_LEN];
+    }
+    xSemaphoreGive(cache_lock);
+
+    register_key_callbacks(true);
+
+    ssd1322_fill(ui_display, 0);
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void draw(void)
+{
+    ssd1322_fill(ui_display, 0);
+    draw_rows();
+    draw_status();
+    request_prefetch();
+}
+
+static void close(void)
+{
+    register_key_callbacks(false);
+
+    // wait for a running read before the pages and the file are gone
+    xSemaphoreTake(file_lock, portMAX_DELAY);
+    xSemaphoreTake(cache_lock, portMAX_DELAY);
+    free(cache_mem);
+    cache_mem = NULL;
+    sdcard_file_close(file);
+    file = NULL;
+    xSemaphoreGive(cache_lock);
+    xSemaphoreGive(file_lock);
+}
+
+static void prefetch_task(void *arg)
+{
+    while (1)
+    {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (prefetch_page != NO_PAGE)
+            cache_load(prefetch_page);
+    }
+}
+
+// returns the cached page, must be called with the cache lock taken
+static page_slot_t *cache_find(uint32_t page)
+{
+    for (int i = 0; i < CACHE_PAGES; ++i)
+    {
+        if (cache[i].page == page)
+        {
+            cache[i].used = ++cache_clock;
+            return &cache[i];
+        }
+    }
+
+    return NULL;
+}
+
+// loads the page in place of an empty slot or else the least recently used
+// one; the SD card is read without the cache lock, so the screen keeps
+// drawing the cached pages meanwhile, false if the page can not be read
+static bool cache_load(uint32_t page)
+{
+    page_slot_t *slot = NULL;
+    int len = -1;
+
+    xSemaphoreTake(file_lock, portMAX_DELAY);
+    xSemaphoreTake(cache_lock, portMAX_DELAY);
+    if (cache_mem == NULL || cache_find(page) != NULL)
+    {
+        // closed, or loaded by the other task while this one waited
+        xSemaphoreGive(cache_lock);
+        xSemaphoreGive(file_lock);
+        return cache_mem != NULL;
+    }
+
+    for (int i = 0; i < CACHE_PAGES; ++i)
+    {
+        if (cache[i].page == NO_PAGE)
+        {
+            slot = &cache[i];
+            break;
+        }
+        if (slot == NULL || cache[i].used < slot->used)
+            slot = &cache[i];
+    }
+
+    // nobody reads the slot while it is empty, only the holder of file_lock fills one
+    slot->page = NO_PAGE;
+    xSemaphoreGive(cache_lock);
+
+    if (sdcard_file_seek(file, (int64_t)page * PAGE_LEN) == SD_OK)
+        len = sdcard_file_read(file, slot->data, PAGE_LEN);
+
+    xSemaphoreTake(cache_lock, portMAX_DELAY);
+    if (len >= 0)
+    {
+        slot->page = page;
+        slot->len = len;
+        slot->used = ++cache_clock;
+    }
+    xSemaphoreGive(cache_lock);
+    xSemaphoreGive(file_lock);
+
+    return len >= 0;
+}
+
+static int read_bytes(uint32_t offset, uint8_t *buf, int len)
+{
+    page_slot_t *slot;
+    int done = 0;
+    int n = 0;
+
+    if (offset >= file_size)
+        return 0;
+    if (len > file_size - offset)
+        len = file_size - offset;
+
+    while (done < len)
+    {
+        uint32_t page = (offset + done) / PAGE_LEN;
+
+        xSemaphoreTake(cache_lock, portMAX_DELAY);
+        slot = (cache_mem != NULL) ? cache_find(page) : NULL;
+        if (slot != NULL)
+        {
+            n = slot->len - (offset + done) % PAGE_LEN;
+            if (n > len - done)
+                n = len - done;
+            if (n > 0)
+                memcpy(&buf[done], &slot->data[(offset + done) % PAGE_LEN], n);
+        }
+        xSemaphoreGive(cache_lock);
+
+        if (slot == NULL)
+        {
+            if (!cache_load(page))
+                break;
+            continue;
+        }
+        if (n <= 0)
+            break;
+        done += n;
+    }
+
+    return done;
+}
+
+// load the page next to the viewport in the scroll direction in background
+static void request_prefetch(void)
+{
+    uint32_t page;
+
+    if (scroll_dir > 0)
+    {
+        page = (view_offset + VIEW_BYTES - 1) / PAGE_LEN + 1;
+        if ((int64_t)page * PAGE_LEN >= file_size)
+            return;
+    }
+    else
+    {
+        page = view_offset / PAGE_LEN;
+        if (page == 0)
+            return;
+        --page;
+    }
+
+    prefetch_page = page;
+    xTaskNotifyGive(prefetch_task_handle);
+}
+
+static void move_to(int64_t offset)
+{
+    int64_t last = 0;
+
+    // keep the last row of the file on the screen
+    if (file_size > VIEW_BYTES)
+        last = ((file_size - 1) / ROW_BYTES - (ROWS - 1)) * ROW_BYTES;
+
+    if (offset > last)
+        offset = last;
+    if (offset < 0)
+        offset = 0;
+
+    view_offset = offset - offset % ROW_BYTES;
+}
+
+static void scroll(int delta)
+{
+    scroll_dir = (delta > 0) ? 1 : -1;
+    move_to((int64_t)view_offset + delta);
+}
+
+static void navigation_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed)
+{
+    switch (k)
+    {
+    case KEY_ARROW_UP:
+        scroll(-ROW_BYTES);
+        break;
+    case KEY_ARROW_DOWN:
+        scroll(ROW_BYTES);
+        break;
+    case KEY_ARROW_LEFT:
+        scroll(-VIEW_BYTES);
+        break;
+    case KEY_ARROW_RIGHT:
+        scroll(VIEW_BYTES);
+        break;
+    default:
+        return;
+    }
+
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void text_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed)
+{
+    char c = keyboard_key_to_char(k, false);
+
+    if (goto_len >= GOTO_LEN)
+        return;
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f')))
+        return;
+
+    goto_str[goto_len++] = c;
+    goto_str[goto_len] = '\0';
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void backspace_key_pressed_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed)
+{
+    if (goto_len <= 0)
+        return;
+
+    goto_str[--goto_len] = '\0';
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void enter_key_released_callback(kbrd_key_t k, kbrd_key_state_t s, bool pressed)
+{
+    // enter without an offset goes back to the calculator
+    if (goto_len == 0)
+    {
+        ui_change_screen(SCREEN_CALCULATION);
+        return;
+    }
+
+    // jump to the row of the typed hex offset, only its pages are read
+    move_to(strtoul(goto_str, NULL, 16));
+    scroll_dir = 1;
+    goto_len = 0;
+    goto_str[0] = '\0';
+    xSemaphoreGive(ui_refresh_sem);
+}
+
+static void register_key_callbacks(bool enable)
+{
+    kbrd_callback_t nav = enable ? navigation_key_pressed_callback : NULL;
+    kbrd_callback_t text = enable ? text_key_pressed_callback : NULL;
+
+    keyboard_register_callback(KEY_ARROW_LEFT, KEY_PRESSED, nav);
+    keyboard_register_callback(KEY_ARROW_RIGHT, KEY_PRESSED, nav);
+    keyboard_register_callback(KEY_ARROW_UP, KEY_PRESSED, nav);
+    keyboard_register_callback(KEY_ARROW_DOWN, KEY_PRESSED, nav);
+    keyboard_register_callback(KEY_ARROW_LEFT, KEY_DOWN, nav);
+    keyboard_register_callback(KEY_ARROW_RIGHT, KEY_DOWN, nav);
+    keyboard_register_callback(KEY_ARROW_UP, KEY_DOWN, nav);
+    keyboard_register_callback(KEY_ARROW_DOWN, KEY_DOWN, nav);
+
+    for (kbrd_key_t k = KEY_1; k <= KEY_0; ++k)
+        keyboard_register_callback(k, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_A, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_B, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_C, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_D, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_E, KEY_PRESSED, text);
+    keyboard_register_callback(KEY_F, KEY_PRESSED, text);
+
+    keyboard_register_callback(KEY_BACKSPACE, KEY_PRESSED, enable ? backspace_key_pressed_callback : NULL);
+    keyboard_register_callback(KEY_ENTER, KEY_RELEASED, enable ? enter_key_released_callback : NULL);
+}
+
+static void draw_rows(void)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    uint8_t data[VIEW_BYTES];
+    char str[ROW_BYTES + 1];
+    int len, row_len, y;
+
+    if (error_msg != NULL)
+        return;
+
+    len = read_bytes(view_offset, data, VIEW_BYTES);
+
+    for (int row = 0; row * ROW_BYTES < len; ++row)
+    {
+        y = 2 + row * 12;
+        row_len = len - row * ROW_BYTES;
+        if (row_len > ROW_BYTES)
+            row_len = ROW_BYTES;
+
+        // low 16 bits of the offset, the full one is in the status line
+        snprintf(str, sizeof(str), "%04X", (unsigned int)(view_offset + row * ROW_BYTES) & 0xFFFF);
+        text_draw_string(ui_display, 2, y, str, &cascadia_pack);
+
+        for (int i = 0; i < row_len; ++i)
+        {
+            uint8_t b = data[row * ROW_BYTES + i];
+            str[0] = hex[b >> 4];
+            str[1] = hex[b & 0x0F];
+            str[2] = '\0';
+            text_draw_string(ui_display, HEX_X + i * HEX_STEP, y, str, &cascadia_pack);
+        }
+
+        for (int i = 0; i < row_len; ++i)
+        {
+            char c = data[row * ROW_BYTES + i];
+            str[i] = (c >= 0x20 && c < 0x7F) ? c : '.';
+        }
+        str[row_len] = '\0';
+        text_draw_string(ui_display, ASCII_X, y, str, &cascadia_pack);
+    }
+
+    ssd1322_draw_vline(ui_display, 0, ui_display->res_y - 16, HEX_X - 4, 4);
+    ssd1322_draw_vline(ui_display, 0, ui_display->res_y - 16, ASCII_X - 4, 4);
+}
+
+static void draw_status(void)
+{
+    char str[48];
+
+    ssd1322_draw_hline(ui_display, 0, ui_display->res_x, ui_display->res_y - 15, 8);
+
+    if (error_msg != NULL)
+        snprintf(str, sizeof(str), "%s: %s", file_name, error_msg);
+    else if (goto_len > 0)
+        snprintf(str, sizeof(str), "goto: %s_", goto_str);
+    else
+        snprintf(str, sizeof(str), "%08X/%08X %s", (unsigned int)view_offset, (unsigned int)file_size, file_name);
+
+    text_draw_string(ui_display, 4, ui_display->res_y - 14, str, &cascadia_pack);
+}
@@ -14,8 +14,8 @@
 #include <sensors.h>
 
 #include "../ssd1322/ssd1322.h"
-#include "../ssd1322/ssd1322_font.h"
-#include "../fonts/cascadia_font.h"
+#include "../fonts/cascadia_pack.h"
+#include "../text/text.h"
 
 extern SemaphoreHandle_t ui_refresh_sem;
 extern ssd1322_t *ui_display;
@@ -79,14 +79,14 @@ static void open(void)
         strcpy(running_app_info.version, "err");
     }
 
-    ssd1322_draw_string(ui_display, 168, 2, running_app_info.version, cascadia_font);
-    ssd1322_draw_string(ui_display, 168, 14, "CPU:", cascadia_font);
+    text_draw_string(ui_display, 168, 2, running_app_info.version, &cascadia_pack);
+    text_draw_string(ui_display, 168, 14, "CPU:", &cascadia_pack);
 
-    ssd1322_draw_string(ui_display, 168, 26, "VBat:", cascadia_font);
+    text_draw_string(ui_display, 168, 26, "VBat:", &cascadia_pack);
     sensor_vbat_callback(SENS_VBAT, sensors_get_value(SENS_VBAT));
-    ssd1322_draw_string(ui_display, 168, 38, "Chrg:", cascadia_font);
+    text_draw_string(ui_display, 168, 38, "Chrg:", &cascadia_pack);
     sensor_chrg_callback(SENS_CHRG, sensors_get_value(SENS_CHRG));
-    ssd1322_draw_string(ui_display, 168, 50, "IsCh:", cascadia_font);
+    text_draw_string(ui_display, 168, 50, "IsCh:", &cascadia_pack);
     sensor_is_chrg_callback(SENS_BAT_CHARGING, sensors_get_value(SENS_BAT_CHARGING));
 
     // register sensors callbacks
@@ -241,7 +241,7 @@ static void cpu_freq_display(void *arg)
     {
         sprintf(cpu_text_buffer, "%uMHz", esp_clk_cpu_freq()/1000000);
         ssd1322_draw_rect_filled(ui_display, 210, 14, 40, 12, 0);
-        ssd1322_draw_string(ui_display, 210, 14, cpu_text_buffer, cascadia_font);
+        text_draw_string(ui_display, 210, 14, cpu_text_buffer, &cascadia_pack);
         xSemaphoreGive(ui_refresh_sem);
         vTaskDelay(1000);
     }
@@ -251,7 +251,7 @@ static void sensor_vbat_callback(sens_t sensor, float value)
 {
     sprintf(vbat_text_buffer, "%.02f", value);
     ssd1322_draw_rect_filled(ui_display, 210, 26, 40, 12, 0);
-    ssd1322_draw_string(ui_display, 210, 26, vbat_text_buffer, cascadia_font);
+    text_draw_string(ui_display, 210, 26, vbat_text_buffer, &cascadia_pack);
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -259,7 +259,7 @@ static void sensor_chrg_callback(sens_t sensor, float value)
 {
     sprintf(chrg_text_buffer, "%.02f", value);
     ssd1322_draw_rect_filled(ui_display, 210, 38, 40, 12, 0);
-    ssd1322_draw_string(ui_display, 210, 38, chrg_text_buffer, cascadia_font);
+    text_draw_string(ui_display, 210, 38, chrg_text_buffer, &cascadia_pack);
     xSemaphoreGive(ui_refresh_sem);
 }
 
@@ -268,9 +268,9 @@ static void sensor_is_chrg_callback(sens_t sensor, float value)
     ssd1322_draw_rect_filled(ui_display, 210, 50, 40, 12, 0);
 
     if (value > 0)
-        ssd1322_draw_string(ui_display, 210, 50, "YES", cascadia_font);
+        text_draw_string(ui_display, 210, 50, "YES", &cascadia_pack);
     else
-        ssd1322_draw_string(ui_display, 210, 50, "NO", cascadia_font);
+        text_draw_string(ui_display, 210, 50, "NO", &cascadia_pack);
 
     xSemaphoreGive(ui_refresh_sem);
 }
@@ -17,8 +17,8 @@
 #include <sdcard.h>
 
 #include "../ssd1322/ssd1322.h"
-#include "../ssd1322/ssd1322_font.h"
-#include "../fonts/cascadia_font.h"
+#include "../fonts/cascadia_pack.h"
+#include "../text/text.h"
 
 extern SemaphoreHandle_t ui_refresh_sem;
 extern ssd1322_t *ui_display;
@@ -54,7 +54,7 @@ static void open(void)
 
     // clear screen and draw initial layout
     ssd1322_fill(ui_display, 0);
-    ssd1322_draw_string(ui_display, 10, ui_display->res_y/2 - 20, "do not turn off the power!!!", cascadia_font);
+    text_draw_string(ui_display, 10, ui_display->res_y/2 - 20, "do not turn off the power!!!", &cascadia_pack);
 
     done = false;
     progress = 0;
@@ -80,7 +80,7 @@ static void upload_task_handler(void *arg)
 {
     const size_t read_buff_size = 2048;
     uint8_t *read_buff = NULL;
-    int total_size = 0;
+    int64_t total_size = 0;
     int read_size = 0;
     int updated_size = 0;
 
@@ -255,7 +255,7 @@ error:
 static void print_error(const char *msg)
 {
     ssd1322_fill(ui_display, 0);
-    ssd1322_draw_string(ui_display, 10, ui_display->res_y/2 + 8, msg, cascadia_font);
+    text_draw_string(ui_display, 10, ui_display->res_y/2 + 8, msg, &cascadia_pack);
 }
 
 static void draw_progress(float progress)
@@ -298,6 +298,6 @@ static void draw_progress(float progress)
 
     if (progress == 1)
     {
-        ssd1322_draw_string(ui_display, 10, half_y + 8, "done, restarting...", cascadia_font);
+        text_draw_string(ui_display, 10, half_y + 8, "done, restarting...", &cascadia_pack);
     }
 }
@@ -0,0 +1,113 @@
+#include "text.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+// 8 pixels of 4 bits
+#define WORD_PIXELS (8)
+
+static void blit_glyph(ssd1322_t *display, int x, int y, const font_pack_t *font, const font_pack_glyph_t *g)
+{
+    int stride = display->res_x / 2;
+    int first = (y < 0) ? -y : 0;
+    int last = (y + g->h > display->res_y) ? display->res_y - y : g->h;
+    uint8_t *dst = &display->framebuffer[(y + first) * stride + x / 2];
+    const uint8_t *src = &font->data[g->offset];
+    uint32_t mask = g->row_mask;
+    uint32_t row;
+    uint8_t *row_bytes = (uint8_t *)&row + g->left / 2;
+
+    // walk the stored rows in order instead of looking each one up,
+    // the mask is shifted to the cell rows and the clipped ones skipped
+    mask = (g->top >= first) ? mask << (g->top - first) : mask >> (first - g->top);
+    if (g->top < first)
+        src += __builtin_popcount(g->row_mask & ((1 << (first - g->top)) - 1)) * g->bytes;
+
+    if (g->w == WORD_PIXELS)
+    {
+        // a whole glyph row is one framebuffer word, aligned if x is
+        bool aligned = x % WORD_PIXELS == 0;
+
+        for (int i = first; i < last; ++i, mask >>= 1)
+        {
+            row = 0;
+            if (mask & 1)
+            {
+                for (int j = 0; j < g->bytes; ++j)
+                    row_bytes[j] = src[j];
+                src += g->bytes;
+            }
+            if (aligned)
+                *(uint32_t *)dst = row;
+            else
+                memcpy(dst, &row, sizeof(row));
+            dst += stride;
+        }
+    }
+    else
+    {
+        for (int i = first; i < last; ++i, mask >>= 1)
+        {
+            memset(dst, 0, g->w / 2);
+            if (mask & 1)
+            {
+                memcpy(&dst[g->left / 2], src, g->bytes);
+                src += g->bytes;
+            }
+            dst += stride;
+        }
+    }
+}
+
+static void draw_glyph(ssd1322_t *display, int x, int y, const font_pack_t *font, const font_pack_glyph_t *g)
+{
+    const uint8_t *src;
+    uint8_t *dst;
+    uint8_t c;
+    int px, py;
+
+    for (int i = 0; i < g->h; ++i)
+    {
+        py = y + i;
+        if (py < 0 || py >= display->res_y || (src = font_pack_row(font, g, i)) == NULL)
+            continue;
+
+        for (int j = 0; j < g->bytes * 2; ++j)
+        {
+            px = x + g->left + j;
+            c = (j % 2) ? src[j / 2] & 0x0F : src[j / 2] >> 4;
+            if (c == 0 || px < 0 || px >= display->res_x)
+                continue;
+
+            // the left pixel of a byte is in the high nibble
+            dst = &display->framebuffer[py * display->res_x / 2 + px / 2];
+            *dst = (px % 2) ? (*dst & 0xF0) | c : (*dst & 0x0F) | (c << 4);
+        }
+    }
+}
+
+void text_draw_string(ssd1322_t *display, int x, int y, const char *str, const font_pack_t *font)
+{
+    const font_pack_glyph_t *g;
+
+    for (; *str != '\0' && *str != '\n' && x < display->res_x; ++str)
+    {
+        g = font_pack_glyph(font, *str);
+
+        if (y >= display->res_y || y + g->h <= 0)
+        {
+            // above or below the screen
+        }
+        else if (x >= 0 && x % 2 == 0 && g->w % 2 == 0 && x + g->w <= display->res_x)
+        {
+            blit_glyph(display, x, y, font, g);
+        }
+        else
+        {
+            draw_glyph(display, x, y, font, g);
+        }
+
+        x += g->w;
+    }
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "../ssd1322/ssd1322.h"
+#include "../fonts/font_pack.h"
+
+// draw a line of a packed 4bpp font up to '\0' or '\n'; glyph cells at even x
+// that fit the screen width are written over the background row by row, so the
+// area has to be cleared before, the others are drawn pixel by pixel transparently
+void text_draw_string(ssd1322_t *display, int x, int y, const char *str, const font_pack_t *font);
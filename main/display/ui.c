@@ -2,23 +2,39 @@
 
 #include <stdio.h>
 #include <esp_log.h>
+#include <esp_timer.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 #include <freertos/semphr.h>
 
 #include <keyboard.h>
+#include <calc.h>
 
 #include "screens/screen.h"
 #include "ssd1322/ssd1322.h"
 #include "ssd1322/ssd1322_bitmap.h"
+#include "panel/panel.h"
+#include "damage/damage.h"
 #include "bitmaps/hexowl_logo_full_bmp.h"
 
+// frame rate cap, invalidations within a frame period are drawn as one frame
+#define UI_DEFAULT_FPS (30)
+// invalidations counted until the next frame at most
+#define UI_PENDING_MAX (255)
+// the 256 px wide glass shows the RAM columns 0x1C..0x5B of the controller,
+// as set by Set_Column_Address(0x1C, 0x5B) in the NHD-3.12-25664 example code
+#define UI_COLUMN_OFFSET (0x1C)
+
 static const int res_x = 256, res_y = 64;
 static const ssd1322_pinmap_t pinmap = {
     .reset = 22,
     .dc = 21,
     .cs = 5,
 };
+static const panel_pinmap_t panel_pinmap = {
+    .dc = 21,
+    .cs = 5,
+};
 
 static spi_host_device_t spi_host = SPI3_HOST;
 static const spi_bus_config_t spi_bus_cfg = {
@@ -34,6 +50,10 @@ static const spi_bus_config_t spi_bus_cfg = {
 ssd1322_t *ui_display;
 SemaphoreHandle_t ui_refresh_sem;
 
+static panel_t *panel;
+static damage_t *damage;
+static volatile uint32_t frame_period = 1000000 / UI_DEFAULT_FPS;
+
 static const ui_screen_t *current_screen;
 
 void ui_task(void *arg)
@@ -54,7 +74,8 @@ void ui_task(void *arg)
         goto error;
     }
 
-    ui_refresh_sem = xSemaphoreCreateBinary();
+    // counting, so the invalidations merged into a frame are known
+    ui_refresh_sem = xSemaphoreCreateCounting(UI_PENDING_MAX, 0);
     if (ui_refresh_sem == NULL)
     {
         ESP_LOGE("disp", "semaphore creation error");
@@ -74,6 +95,21 @@ void ui_task(void *arg)
     ssd1322_draw_bitmap(ui_display, 12, 7, hexowl_logo_full);
     ssd1322_send_framebuffer(ui_display);
 
+    // the logo is the last transfer of the driver, the frames go through the panel
+    panel = panel_init(spi_host, panel_pinmap, UI_COLUMN_OFFSET);
+    if (panel == NULL)
+    {
+        ESP_LOGE("disp", "panel initialization error");
+        goto error;
+    }
+
+    damage = damage_init(ui_display, panel);
+    if (damage == NULL)
+    {
+        ESP_LOGE("disp", "damage tracking initialization error");
+        goto error;
+    }
+
     // open first or test screen
     vTaskDelay(700);
     if (keyboard_is_key_pressed(KEY_TILDA))
@@ -89,14 +125,28 @@ void ui_task(void *arg)
         current_screen = ui_screens[0];
     }
     current_screen->open();
-    ssd1322_send_framebuffer(ui_display);
+    damage_flush(damage);
 
+    int64_t frame_time = esp_timer_get_time();
     while (1)
     {
         if (xSemaphoreTake(ui_refresh_sem, portMAX_DELAY))
         {
+            // hold the frame until its period is over, later invalidations join it
+            int64_t wait = frame_time + frame_period - esp_timer_get_time();
+            if (wait > 0)
+                vTaskDelay(pdMS_TO_TICKS((wait + 999) / 1000));
+
+            uint32_t coalesced = 0;
+            while (xSemaphoreTake(ui_refresh_sem, 0))
+                ++coalesced;
+
+            frame_time = esp_timer_get_time();
             current_screen->draw();
-            ssd1322_send_framebuffer(ui_display);
+
+            // only the changed windows are queued, the next frame is drawn during the DMA
+            uint32_t sent = damage_flush(damage);
+            calc_perf_frame(esp_timer_get_time() - frame_time, sent, coalesced);
         }
     }
 
@@ -110,3 +160,15 @@ void ui_change_screen(ui_screen_num_t screen)
     current_screen = ui_screens[screen];
     current_screen->open();
 }
+
+void ui_set_fps(int fps)
+{
+    frame_period = (fps > 0) ? 1000000 / fps : 0;
+}
+
+int ui_get_fps(void)
+{
+    uint32_t period = frame_period;
+
+    return (period > 0) ? 1000000 / period : 0;
+}
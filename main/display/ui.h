@@ -5,3 +5,11 @@
 void ui_task(void *arg);
 
 void ui_change_screen(ui_screen_num_t screen);
+
+// cap the frame rate, 0 draws every invalidation right away
+void ui_set_fps(int fps);
+// frame rate cap, 0 if there is none
+int ui_get_fps(void);
+// register the builtins of the display, called from the calc task through
+// calc_args_t once hexowl takes them
+void ui_register_builtins(void);
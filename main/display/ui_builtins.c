@@ -0,0 +1,38 @@
+#include "ui.h"
+
+#include <string.h>
+#include <hexowl.h>
+#include <native/native.h>
+
+// the frames are scheduled in ticks, a shorter period is not kept
+#define FPS_MAX (1000)
+
+static const char *builtin_fps(const hexowl_value_t *args, int argc, hexowl_value_t *ret)
+{
+    uint64_t fps;
+    const char *err;
+
+    if (argc > 0)
+    {
+        if ((err = native_arg_uint(&args[0], &fps)) != NULL)
+            return err;
+        if (fps > FPS_MAX)
+            return "fps out of range";
+        ui_set_fps(fps);
+    }
+
+    native_ret_uint(ret, ui_get_fps());
+    return NULL;
+}
+
+static GoString go_string(const char *str)
+{
+    return (GoString){str, strlen(str)};
+}
+
+void ui_register_builtins(void)
+{
+    HexowlRegisterNative(go_string("fps"), go_string("([n])"),
+                         go_string("display frame rate cap, 0 draws every change at once"),
+                         0, 1, HEXOWL_NATIVE_IMPURE, builtin_fps);
+}
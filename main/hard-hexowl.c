@@ -5,6 +5,7 @@
 #include <esp_log.h>
 #include <esp_ota_ops.h>
 #include <esp_private/esp_clk.h>
+#include <nvs_flash.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
@@ -15,12 +16,9 @@
 
 // calc task stuff
 extern void calc_task(void *arg);
-const uintptr_t calc_task_stack_size = 2 * 1024 * 1024;
 StaticTask_t calc_static_task;
 StackType_t *calc_stack;
-static calc_args_t calc_task_args = {
-    .heap_size = 256 * 1024,
-};
+static calc_args_t calc_task_args;
 
 // ui task stuff
 #define UI_STACK_SIZE (2048+256)
@@ -46,8 +44,24 @@ void app_main(void)
     const esp_partition_t *running = esp_ota_get_running_partition();
     esp_ota_get_state_partition(running, &ota_state);
 
+    esp_err_t err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND)
+    {
+        nvs_flash_erase();
+        err = nvs_flash_init();
+    }
+    if (err != ESP_OK)
+    {
+        ESP_LOGW("main", "nvs initialization error, using default memory plan\r\n");
+    }
+
     // allocate and run calc task
-    calc_stack = heap_caps_malloc(calc_task_stack_size, MALLOC_CAP_SPIRAM);
+    if (!calc_plan_memory(&calc_task_args))
+    {
+        ESP_LOGE("main", "not enough memory for the calc task\r\n");
+        goto error;
+    }
+    calc_stack = heap_caps_malloc(calc_task_args.stack_size, MALLOC_CAP_SPIRAM);
     if (calc_stack == NULL)
     {
         ESP_LOGE("main", "unable to allocate the calc task stack\r\n");
@@ -64,10 +78,11 @@ void app_main(void)
     calc_task_args.firmware_version = malloc((strlen(running_app_info->version)+1)*sizeof(char));
     strcpy(calc_task_args.firmware_version, running_app_info->version);
     free(running_app_info);
+    calc_task_args.register_builtins = ui_register_builtins;
 
     if (!xTaskCreateStaticPinnedToCore(
             calc_task, "calc",
-            calc_task_stack_size, (void *)&calc_task_args,
+            calc_task_args.stack_size, (void *)&calc_task_args,
             0, calc_stack, &calc_static_task, 1))
     {
         ESP_LOGE("main", "unable to run the calc task\r\n");
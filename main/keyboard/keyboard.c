@@ -97,6 +97,7 @@ static const char key_to_char_table[KEY_COUNT][2] = {
 
 static uint8_t keys[KEY_COUNT] = {0};
 static kbrd_key_clbk_t callbacks[KEY_COUNT] = {0};
+static kbrd_activity_callback_t activity_callback = NULL;
 
 static void scan(void);
 static void wait_extint(void);
@@ -113,6 +114,16 @@ inline bool keyboard_is_key_pressed(kbrd_key_t key)
     return keys[key] > 0;
 }
 
+void keyboard_register_activity_callback(kbrd_activity_callback_t clbk)
+{
+    activity_callback = clbk;
+}
+
+bool keyboard_is_idle(void)
+{
+    return xTaskGetTickCount() > kb_sleep_time;
+}
+
 inline char keyboard_key_to_char(kbrd_key_t key, bool shifted)
 {
     return key_to_char_table[key][shifted];
@@ -210,6 +221,9 @@ static void scan(void)
             // execute callbacks
             if (key_val != (keys[key] > 0))
             {
+                if (key_val && activity_callback != NULL)
+                    activity_callback();
+
                 if (key_val && callbacks[key][KEY_PRESSED] != NULL)
                     callbacks[key][KEY_PRESSED](key, KEY_PRESSED, key_val);
                 else if (!key_val && callbacks[key][KEY_RELEASED] != NULL)
@@ -74,9 +74,13 @@ typedef enum {
 } kbrd_key_state_t;
 
 typedef void (*kbrd_callback_t)(kbrd_key_t k, kbrd_key_state_t s, bool pressed);
+// executed from the keyboard task on every key press before the key callbacks
+typedef void (*kbrd_activity_callback_t)(void);
 
 void keyboard_task(void *arg);
 
 void keyboard_register_callback(kbrd_key_t key, kbrd_key_state_t state, kbrd_callback_t clbk);
 bool keyboard_is_key_pressed(kbrd_key_t key);
+void keyboard_register_activity_callback(kbrd_activity_callback_t clbk);
+bool keyboard_is_idle(void);
 char keyboard_key_to_char(kbrd_key_t key, bool shifted);
@@ -8,18 +8,61 @@
 
 #include <esp_vfs_fat.h>
 #include <esp_log.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
 #include <sdmmc_cmd.h>
 #include <driver/sdmmc_host.h>
 #include <driver/gpio.h>
 
 #define BASE_PATH_LEN (sizeof(sd_mount_point) + sizeof(sd_env_dir) - 2)
+#define PATH_LEN (BASE_PATH_LEN + SDCARD_MAX_FILE_NAME + 7)
 
 sdmmc_card_t *sd_card = NULL;
 
 static const char sd_mount_point[] = SDCARD_MOUNT_POINT;
 static const char sd_env_dir[] = SDCARD_ENVIRONMENT_DIR;
+// the file of the environment hooks, only the calc task uses it
 static FILE *file = NULL;
-static char file_path[BASE_PATH_LEN + SDCARD_MAX_FILE_NAME + 7] = {SDCARD_MOUNT_POINT SDCARD_ENVIRONMENT_DIR};
+
+static portMUX_TYPE mount_lock_mux = portMUX_INITIALIZER_UNLOCKED;
+static StaticSemaphore_t mount_lock_buf;
+static SemaphoreHandle_t mount_lock;
+
+// the calc, ui and prefetch tasks may all mount the card on their first access
+static void lock_mount(void)
+{
+    taskENTER_CRITICAL(&mount_lock_mux);
+    if (mount_lock == NULL)
+        mount_lock = xSemaphoreCreateMutexStatic(&mount_lock_buf);
+    taskEXIT_CRITICAL(&mount_lock_mux);
+
+    xSemaphoreTake(mount_lock, portMAX_DELAY);
+}
+
+static void unlock_mount(void)
+{
+    xSemaphoreGive(mount_lock);
+}
+
+// full path of a file in the environment dir, names without an extension
+// get ext appended when it is not NULL, so every caller has its own path
+static sd_err_t make_path(char *path, const char *fname, const char *ext)
+{
+    int len;
+
+    if (strlen(fname) > SDCARD_MAX_FILE_NAME)
+    {
+        ESP_LOGE("sdcard", "too long file name '%s'", fname);
+        return SD_LONG_NAME;
+    }
+
+    if (ext != NULL && strchr(fname, '.') == NULL)
+        len = snprintf(path, PATH_LEN, "%s%s/%s%s", sd_mount_point, sd_env_dir, fname, ext);
+    else
+        len = snprintf(path, PATH_LEN, "%s%s/%s", sd_mount_point, sd_env_dir, fname);
+
+    return (len < PATH_LEN) ? SD_OK : SD_LONG_NAME;
+}
 
 bool sdcard_is_inserted(void)
 {
@@ -32,7 +75,7 @@ bool sdcard_is_mounted(void)
     return sd_card != NULL;
 }
 
-sd_err_t sdcard_mount(void)
+static sd_err_t mount(void)
 {
     if (!sdcard_is_inserted())
     {
@@ -73,7 +116,8 @@ sd_err_t sdcard_mount(void)
         if (mkdir(SDCARD_MOUNT_POINT SDCARD_ENVIRONMENT_DIR, 0755) != 0)
         {
             ESP_LOGE("sdcard", "environment directory creation error.");
-            sdcard_unmount();
+            esp_vfs_fat_sdcard_unmount(sd_mount_point, sd_card);
+            sd_card = NULL;
             return SD_MKDIR_ERR;
         }
     }
@@ -82,68 +126,85 @@ sd_err_t sdcard_mount(void)
     return SD_OK;
 }
 
+sd_err_t sdcard_mount(void)
+{
+    sd_err_t ret;
+
+    lock_mount();
+    ret = sdcard_is_mounted() ? SD_OK : mount();
+    unlock_mount();
+
+    return ret;
+}
+
 sd_err_t sdcard_unmount(void)
 {
-    esp_vfs_fat_sdcard_unmount(sd_mount_point, sd_card);
+    lock_mount();
+    if (sd_card != NULL)
+        esp_vfs_fat_sdcard_unmount(sd_mount_point, sd_card);
     sd_card = NULL;
+    unlock_mount();
+
     return SD_OK;
 }
 
-int sdcard_file_size(const char *fname)
+static int64_t file_size(const char *fname, const char *ext)
 {
+    char path[PATH_LEN];
     struct stat st;
+    sd_err_t err;
 
-    if (strlen(fname) > SDCARD_MAX_FILE_NAME)
+    err = make_path(path, fname, ext);
+    if (err != SD_OK)
     {
-        ESP_LOGE("sdcard", "too long file name '%s'", fname);
-        return SD_LONG_NAME;
+        return err;
     }
 
-    if (strchr(fname, '.') == NULL)
+    if (stat(path, &st) < 0)
     {
-        snprintf(file_path + BASE_PATH_LEN, SDCARD_MAX_FILE_NAME, "/%s.json", fname);
-    }
-    else
-    {
-        snprintf(file_path + BASE_PATH_LEN, SDCARD_MAX_FILE_NAME, "/%s", fname);
+        return SD_NOT_EXISTS;
     }
 
-    if (stat(file_path, &st) < 0)
+    // FAT files reach 4 GB - 1, a 32 bit off_t shows the ones over 2 GB as negative
+    if (sizeof(st.st_size) == sizeof(uint32_t))
     {
-        return SD_NOT_EXISTS;
+        return (uint32_t)st.st_size;
     }
-
     return st.st_size;
 }
 
-sd_err_t sdcard_open(const char *fname, const char *mode)
+static sd_err_t file_open(FILE **f, const char *fname, const char *ext, const char *mode)
 {
-    if (strlen(fname) > SDCARD_MAX_FILE_NAME)
-    {
-        ESP_LOGE("sdcard", "too long file name '%s'", fname);
-        return SD_LONG_NAME;
-    }
+    char path[PATH_LEN];
+    sd_err_t err;
 
-    if (strchr(fname, '.') == NULL)
-    {
-        snprintf(file_path + BASE_PATH_LEN, SDCARD_MAX_FILE_NAME, "/%s.json", fname);
-    }
-    else
+    err = make_path(path, fname, ext);
+    if (err != SD_OK)
     {
-        snprintf(file_path + BASE_PATH_LEN, SDCARD_MAX_FILE_NAME, "/%s", fname);
+        return err;
     }
 
-    file = fopen(file_path, mode);
-    if (file == NULL)
+    *f = fopen(path, mode);
+    if (*f == NULL)
     {
-        ESP_LOGE("sdcard", "unable to open file: %s '%s'", file_path, mode);
+        ESP_LOGE("sdcard", "unable to open file: %s '%s'", path, mode);
         return SD_NOT_EXISTS;
     }
 
-    fseek(file, 0, SEEK_SET);
+    fseek(*f, 0, SEEK_SET);
     return SD_OK;
 }
 
+int64_t sdcard_file_size(const char *fname)
+{
+    return file_size(fname, ".json");
+}
+
+sd_err_t sdcard_open(const char *fname, const char *mode)
+{
+    return file_open(&file, fname, ".json", mode);
+}
+
 sd_err_t sdcard_close(void)
 {
     if (file == NULL) {
@@ -151,6 +212,7 @@ sd_err_t sdcard_close(void)
     }
 
     fclose(file);
+    file = NULL;
     return SD_OK;
 }
 
@@ -173,3 +235,42 @@ int sdcard_write(const void *inbuf, size_t size)
     }
     return n;
 }
+
+int64_t sdcard_file_size_raw(const char *fname)
+{
+    return file_size(fname, NULL);
+}
+
+sd_err_t sdcard_file_open(sdcard_file_t *f, const char *fname, const char *mode)
+{
+    return file_open(f, fname, NULL, mode);
+}
+
+sd_err_t sdcard_file_close(sdcard_file_t f)
+{
+    if (f != NULL)
+    {
+        fclose(f);
+    }
+    return SD_OK;
+}
+
+sd_err_t sdcard_file_seek(sdcard_file_t f, int64_t offset)
+{
+    // an offset off_t can not hold is past what the VFS reaches
+    if ((off_t)offset != offset || fseeko(f, offset, SEEK_SET) != 0)
+    {
+        return SD_READ_FAIL;
+    }
+    return SD_OK;
+}
+
+int sdcard_file_read(sdcard_file_t f, void *outbuf, size_t size)
+{
+    size_t n = fread(outbuf, 1, size, f);
+    if (n < size && ferror(f))
+    {
+        return SD_READ_FAIL;
+    }
+    return n;
+}
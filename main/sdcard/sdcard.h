@@ -1,6 +1,8 @@
 #pragma once
 
+#include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
 #define SDCARD_MOUNT_POINT      "/sdcard"
@@ -25,9 +27,21 @@ bool sdcard_is_mounted(void);
 sd_err_t sdcard_mount(void);
 sd_err_t sdcard_unmount(void);
 
-int sdcard_file_size(const char *fname);
+int64_t sdcard_file_size(const char *fname);
 sd_err_t sdcard_open(const char *fname, const char *mode);
 sd_err_t sdcard_close(void);
 
 int sdcard_read(void *outbuf, size_t size);
 int sdcard_write(const void *inbuf, size_t size);
+
+// the functions above share one file of the environment hooks and append
+// ".json" to names without an extension; the ones below take the name as is
+// and work on a handle of their own, so any task may read a file any time
+typedef FILE *sdcard_file_t;
+
+int64_t sdcard_file_size_raw(const char *fname);
+sd_err_t sdcard_file_open(sdcard_file_t *f, const char *fname, const char *mode);
+sd_err_t sdcard_file_close(sdcard_file_t f);
+sd_err_t sdcard_file_seek(sdcard_file_t f, int64_t offset);
+
+int sdcard_file_read(sdcard_file_t f, void *outbuf, size_t size);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stddef.h>
+
+// the calc task and the Enter key of the first commit, for the byte count of
+// test_calc_bytes
+
+// starts the old calc task and waits until it is initialized
+void baseline_start(void);
+// what the Enter key did with the input line, the scrollback is cleared before
+void baseline_enter(const char *input);
+// the scrollback written by baseline_enter
+const char *baseline_scrollback(void);
@@ -0,0 +1,85 @@
+#include "baseline.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#include "calc.h"
+
+#define OUTPUT_BUFFER_LEN (1024 * 16)
+#define INPUT_BUFFER_LEN (1024)
+
+// created by calc_task, not in calc.h of that time
+extern SemaphoreHandle_t calc_in_lock_mux;
+
+// the scrollback and the Enter key of screen_calc.c, without the drawing
+static char text_buffer[INPUT_BUFFER_LEN*2];
+static char output_buffer[OUTPUT_BUFFER_LEN+1] = {'\0'};
+static int output_buffer_len = 0;
+static int output_buffer_lines_cnt = 0;
+
+static calc_args_t args = {
+    .firmware_version = "test",
+    .heap_size = 256 * 1024,
+};
+
+static void output_string(const char *str)
+{
+    if (str == NULL) return;
+
+    int lines_cnt = 0;
+    const char *s;
+
+    // count new line symbols
+    for (s = str; *s != '\0'; ++s)
+    {
+        if (*s == '\n')
+            ++lines_cnt;
+    }
+    output_buffer_lines_cnt += lines_cnt;
+
+    int str_len = s - str;
+
+    // free space for new string
+    if (output_buffer_len + str_len > OUTPUT_BUFFER_LEN)
+    {
+        int dif_len = (output_buffer_len + str_len + 1) - OUTPUT_BUFFER_LEN;
+        memmove(output_buffer, &output_buffer[dif_len], output_buffer_len - dif_len);
+        output_buffer_len -= dif_len;
+    }
+
+    memcpy(&output_buffer[output_buffer_len], str, str_len);
+    output_buffer_len += str_len;
+
+    output_buffer[output_buffer_len] = '\0';
+}
+
+void baseline_start(void)
+{
+    xTaskCreate(calc_task, "calc-old", 256 * 1024, &args, 5, NULL);
+
+    // calc_expression only needs the semaphores, the task picks the input up
+    // once hexowl is initialized
+    while (calc_in_lock_mux == NULL)
+        vTaskDelay(1);
+}
+
+void baseline_enter(const char *input)
+{
+    output_buffer_len = 0;
+    output_buffer_lines_cnt = 0;
+    output_buffer[0] = '\0';
+
+    sprintf(text_buffer, ">: %s\n", input);
+    output_string(text_buffer);
+    calc_expression(input);
+    output_string(calc_await_expression());
+}
+
+const char *baseline_scrollback(void)
+{
+    return output_buffer;
+}
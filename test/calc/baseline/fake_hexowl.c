@@ -0,0 +1,67 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hexowl.h>
+#include <numfmt.h>
+
+// the evaluator of ../fake_hexowl.c behind the exports of the first commit,
+// with the copies their Go side made: C.GoString of the input and
+// fmt.Sprintf of dec, hex and bin; the strings live until the next call,
+// like the Go heap keeps them until a collection
+static char *input;
+static char vals[3][NUMFMT_MAX_LEN];
+
+hexowl_calculate_return_t HexowlCalculate(const char *str)
+{
+    hexowl_calculate_return_t r = {0};
+    size_t len = strlen(str), digits;
+    unsigned long long val;
+
+    free(input);
+    // the terminator only bounds strtoull, a Go string has none
+    input = malloc(len + 1);
+    memcpy(input, str, len);
+    input[len] = '\0';
+
+    digits = len;
+    while (digits > 0 && isdigit((unsigned char)input[digits - 1]))
+        --digits;
+
+    if (digits == len)
+    {
+        r.decVal.n = snprintf(vals[0], sizeof(vals[0]), "%s", "undefined");
+        r.decVal.p = vals[0];
+        return r;
+    }
+
+    val = strtoull(&input[digits], NULL, 10);
+    r.success = 1;
+    r.decVal.n = snprintf(vals[0], sizeof(vals[0]), "%llu", val);
+    r.decVal.p = vals[0];
+    r.hexVal.n = snprintf(vals[1], sizeof(vals[1]), "0x%llX", val);
+    r.hexVal.p = vals[1];
+    // %b is not in printf, numfmt writes the same digits
+    r.binVal.n = numfmt_bin(vals[2], val, 0);
+    r.binVal.p = vals[2];
+    return r;
+}
+
+void HexowlInit(
+    const char *firmware_version,
+    GoUint32 print_limit,
+    hexowl_print_func_t printfunc,
+    hexowl_clear_func_t clearfunc,
+    hexowl_flist_func_t listfunc,
+    hexowl_fopen_func_t openfunc,
+    hexowl_fclose_func_t closefunc,
+    hexowl_fwrite_func_t writefunc,
+    hexowl_fread_func_t readfunc)
+{
+}
+
+GoUint64 GetFreeMem()
+{
+    return 0;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+// calc.c, calc.h and hexowl.h of this directory are the sources of the first
+// commit, copied without changes; their global names are moved aside here, so
+// the old path links into one test program with the new one
+#define calc_task baseline_calc_task
+#define calc_begin_sem baseline_calc_begin_sem
+#define calc_in_lock_mux baseline_calc_in_lock_mux
+#define calc_out_sem baseline_calc_out_sem
+#define calc_out_done_sem baseline_calc_out_done_sem
+#define calc_done_sem baseline_calc_done_sem
+#define calc_expression baseline_calc_expression
+#define calc_await_expression baseline_calc_await_expression
+#define calc_await_output baseline_calc_await_output
+#define calc_done_output baseline_calc_done_output
+#define HexowlCalculate baseline_HexowlCalculate
+#define HexowlInit baseline_HexowlInit
+#define GetFreeMem baseline_GetFreeMem
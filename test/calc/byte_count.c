@@ -0,0 +1,106 @@
+#include "byte_count.h"
+
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <numfmt.h>
+
+volatile bool byte_count_on;
+volatile size_t byte_count;
+
+static void count(size_t n)
+{
+    if (byte_count_on)
+        __atomic_add_fetch(&byte_count, n, __ATOMIC_RELAXED);
+}
+
+void *__real_memcpy(void *dest, const void *src, size_t n);
+void *__real_memmove(void *dest, const void *src, size_t n);
+char *__real_strcpy(char *dest, const char *src);
+int __real_numfmt_udec(char *buf, uint64_t val);
+int __real_numfmt_dec(char *buf, int64_t val);
+int __real_numfmt_hex(char *buf, uint64_t val);
+int __real_numfmt_bin(char *buf, uint64_t val, int group);
+int __real_numfmt_float(char *buf, double val);
+
+void *__wrap_memcpy(void *dest, const void *src, size_t n)
+{
+    count(n);
+    return __real_memcpy(dest, src, n);
+}
+
+void *__wrap_memmove(void *dest, const void *src, size_t n)
+{
+    count(n);
+    return __real_memmove(dest, src, n);
+}
+
+char *__wrap_strcpy(char *dest, const char *src)
+{
+    count(strlen(src) + 1);
+    return __real_strcpy(dest, src);
+}
+
+int __wrap_sprintf(char *str, const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsprintf(str, format, args);
+    va_end(args);
+
+    count(n + 1);
+    return n;
+}
+
+int __wrap_snprintf(char *str, size_t size, const char *format, ...)
+{
+    va_list args;
+    int n;
+
+    va_start(args, format);
+    n = vsnprintf(str, size, format, args);
+    va_end(args);
+
+    if (size > 0)
+        count((size_t)n < size ? n + 1 : size);
+    return n;
+}
+
+int __wrap_numfmt_udec(char *buf, uint64_t val)
+{
+    int n = __real_numfmt_udec(buf, val);
+    count(n + 1);
+    return n;
+}
+
+int __wrap_numfmt_dec(char *buf, int64_t val)
+{
+    int n = __real_numfmt_dec(buf, val);
+    count(n + 1);
+    return n;
+}
+
+int __wrap_numfmt_hex(char *buf, uint64_t val)
+{
+    int n = __real_numfmt_hex(buf, val);
+    count(n + 1);
+    return n;
+}
+
+int __wrap_numfmt_bin(char *buf, uint64_t val, int group)
+{
+    int n = __real_numfmt_bin(buf, val, group);
+    count(n + 1);
+    return n;
+}
+
+int __wrap_numfmt_float(char *buf, double val)
+{
+    int n = __real_numfmt_float(buf, val);
+    count(n + 1);
+    return n;
+}
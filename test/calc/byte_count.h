@@ -0,0 +1,10 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// test_calc_bytes links with --wrap of memcpy, memmove, strcpy, sprintf,
+// snprintf and the numfmt functions; while byte_count_on is set, every byte
+// they copy or write is added to byte_count, from any thread
+extern volatile bool byte_count_on;
+extern volatile size_t byte_count;
@@ -0,0 +1,75 @@
+#include "calc_harness.h"
+
+#include <string.h>
+
+#include <esp_timer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#include "fake_hexowl.h"
+
+static SemaphoreHandle_t output_lock;
+static harness_output_t output;
+static calc_args_t args = {
+    .firmware_version = "test",
+    .heap_size = 256 * 1024,
+    .stack_size = 256 * 1024,
+};
+
+static void writer_begin(void)
+{
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+}
+
+static void writer_write(const char *str, int len)
+{
+    if (len > sizeof(output.text) - output.len)
+        len = sizeof(output.text) - output.len;
+
+    memcpy(&output.text[output.len], str, len);
+    output.len += len;
+    ++output.writes;
+}
+
+static void writer_end(void)
+{
+    xSemaphoreGive(output_lock);
+}
+
+static const calc_writer_t writer = {
+    .begin = writer_begin,
+    .write = writer_write,
+    .end = writer_end,
+};
+
+int64_t harness_now_us(void)
+{
+    return esp_timer_get_time();
+}
+
+void harness_start(void)
+{
+    output_lock = xSemaphoreCreateMutex();
+    calc_set_writer(&writer);
+    xTaskCreate(calc_task, "calc", args.stack_size, &args, 5, NULL);
+
+    while (!fake_hexowl_ready)
+        vTaskDelay(1);
+}
+
+void harness_output(harness_output_t *out)
+{
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+    memcpy(out, &output, sizeof(output));
+    out->text[out->len < sizeof(out->text) ? out->len : sizeof(out->text) - 1] = '\0';
+    xSemaphoreGive(output_lock);
+}
+
+void harness_clear_output(void)
+{
+    xSemaphoreTake(output_lock, portMAX_DELAY);
+    output.len = 0;
+    output.writes = 0;
+    xSemaphoreGive(output_lock);
+}
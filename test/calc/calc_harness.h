@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <calc.h>
+
+// the scrollback of the test, what the calc task writes through calc_writer_t
+typedef struct {
+    char text[64 * 1024];
+    size_t len;
+    size_t writes;
+} harness_output_t;
+
+// starts the calc task with the fake evaluator and waits until it takes requests
+void harness_start(void);
+// a copy of the output written so far, taken under the writer lock
+void harness_output(harness_output_t *out);
+void harness_clear_output(void);
+int64_t harness_now_us(void);
@@ -0,0 +1,36 @@
+// the modules around the calc task that reach the hardware: no SD card
+// is inserted, the keyboard is idle and the clock is not scaled
+
+#include <sdcard.h>
+#include <keyboard.h>
+
+#include "governor/governor.h"
+#include "native/native.h"
+
+bool sdcard_is_inserted(void) { return false; }
+bool sdcard_is_mounted(void) { return false; }
+sd_err_t sdcard_mount(void) { return SD_NOT_INSERTED; }
+sd_err_t sdcard_unmount(void) { return SD_OK; }
+int64_t sdcard_file_size(const char *fname) { return SD_NOT_INSERTED; }
+sd_err_t sdcard_open(const char *fname, const char *mode) { return SD_NOT_INSERTED; }
+sd_err_t sdcard_close(void) { return SD_OK; }
+int sdcard_read(void *outbuf, size_t size) { return SD_NOT_INSERTED; }
+int sdcard_write(const void *inbuf, size_t size) { return SD_NOT_INSERTED; }
+int64_t sdcard_file_size_raw(const char *fname) { return SD_NOT_INSERTED; }
+sd_err_t sdcard_file_open(sdcard_file_t *f, const char *fname, const char *mode) { return SD_NOT_INSERTED; }
+sd_err_t sdcard_file_close(sdcard_file_t f) { return SD_OK; }
+sd_err_t sdcard_file_seek(sdcard_file_t f, int64_t offset) { return SD_NOT_INSERTED; }
+int sdcard_file_read(sdcard_file_t f, void *outbuf, size_t size) { return SD_NOT_INSERTED; }
+
+void keyboard_register_activity_callback(kbrd_activity_callback_t clbk) {}
+bool keyboard_is_idle(void) { return true; }
+
+bool governor_init(uint32_t min_mhz, uint32_t max_mhz, uint32_t decay_ms) { return true; }
+void governor_set_decay(uint32_t decay_ms) {}
+uint32_t governor_get_decay(void) { return 0; }
+void governor_boost(void) {}
+void governor_get_stats(governor_stats_t *stats) { *stats = (governor_stats_t){0}; }
+
+void native_register(void) {}
+void native_interrupt(void) {}
+void native_reset(void) {}
@@ -0,0 +1,153 @@
+#include "fake_hexowl.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hexowl.h>
+#include <calc.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+volatile uint32_t fake_hexowl_slow_ms = 300;
+volatile bool fake_hexowl_busy;
+volatile bool fake_hexowl_ready;
+volatile uint32_t fake_hexowl_calls;
+
+static volatile bool interrupted;
+static int input_buffers;
+static const char undefined[] = "undefined";
+
+void gorun(uintptr_t heap_size)
+{
+}
+
+static hexowl_calculate_return_t calculate(GoString input)
+{
+    hexowl_calculate_return_t r = {0};
+    size_t digits = input.n;
+
+    ++fake_hexowl_calls;
+    fake_hexowl_busy = true;
+
+    if (input.n >= 4 && memcmp(input.p, "slow", 4) == 0)
+    {
+        for (uint32_t ms = 0; ms < fake_hexowl_slow_ms && !interrupted; ++ms)
+            vTaskDelay(1);
+    }
+
+    while (digits > 0 && isdigit((unsigned char)input.p[digits - 1]))
+        --digits;
+
+    if (interrupted)
+    {
+        r.interrupted = 1;
+    }
+    else if (digits == input.n)
+    {
+        r.decVal = (GoString){undefined, sizeof(undefined) - 1};
+    }
+    else
+    {
+        r.success = 1;
+        r.kind = HEXOWL_RESULT_UINT;
+        r.rawVal = strtoull(&input.p[digits], NULL, 10);
+    }
+
+    fake_hexowl_busy = false;
+    return r;
+}
+
+hexowl_calculate_return_t HexowlCalculate(GoString input)
+{
+    return calculate(input);
+}
+
+hexowl_calculate_return_t HexowlPreview(GoString input)
+{
+    return calculate(input);
+}
+
+hexowl_calculate_batch_return_t HexowlCalculateBatch(GoString input, hexowl_result_func_t resultfunc)
+{
+    hexowl_calculate_batch_return_t ret = {0};
+    const char *p = input.p, *end = input.p + input.n;
+
+    while (p < end && !interrupted)
+    {
+        const char *nl = memchr(p, '\n', end - p);
+        GoString line = {p, (nl != NULL ? nl : end) - p};
+        hexowl_calculate_return_t r;
+
+        p = (nl != NULL) ? nl + 1 : end;
+        if (line.n == 0)
+            continue;
+
+        r = calculate(line);
+        ++ret.lines;
+        if (!r.success)
+            ++ret.failed;
+        if (resultfunc != NULL)
+            resultfunc(ret.lines, line, &r);
+    }
+
+    ret.interrupted = interrupted;
+    return ret;
+}
+
+void HexowlInit(const char *firmware_version, GoUint32 print_limit, hexowl_print_func_t printfunc,
+                hexowl_clear_func_t clearfunc, hexowl_flist_func_t listfunc, hexowl_fopen_func_t openfunc,
+                hexowl_fclose_func_t closefunc, hexowl_fwrite_func_t writefunc, hexowl_fread_func_t readfunc)
+{
+}
+
+// the fake keeps no tree, a slot always keeps its buffer
+char *HexowlInputBuffer(char *buf, GoUint32 size)
+{
+    if (buf != NULL)
+        return buf;
+
+    if (++input_buffers == CALC_QUEUE_DEPTH)
+        fake_hexowl_ready = true;
+    return malloc(size);
+}
+
+GoUint64 GetFreeMem()
+{
+    return 0;
+}
+
+void HexowlStats(hexowl_stats_t *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+}
+
+void HexowlRegisterNative(GoString name, GoString args, GoString desc, GoUint8 min_args, GoUint8 max_args,
+                          GoUint8 flags, hexowl_native_func_t nativefunc)
+{
+}
+
+void HexowlPhases(hexowl_phases_t *phases)
+{
+    memset(phases, 0, sizeof(*phases));
+}
+
+void HexowlSetPerfFunc(hexowl_perf_func_t perffunc)
+{
+}
+
+GoUint32 HexowlCollect(GoUint8 threshold)
+{
+    return 0;
+}
+
+void HexowlInterrupt()
+{
+    interrupted = true;
+}
+
+void HexowlBeginRequest()
+{
+    interrupted = false;
+}
+
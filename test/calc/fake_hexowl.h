@@ -0,0 +1,14 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// the evaluator of the fake: an input ending with digits evaluates to that
+// number, anything else is an error; inputs starting with "slow" take
+// fake_hexowl_slow_ms first and may be interrupted meanwhile
+extern volatile uint32_t fake_hexowl_slow_ms;
+// set while a calculation or a preview runs
+extern volatile bool fake_hexowl_busy;
+// the calc task has the buffers of all its request slots and takes requests
+extern volatile bool fake_hexowl_ready;
+extern volatile uint32_t fake_hexowl_calls;
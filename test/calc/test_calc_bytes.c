@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "calc_harness.h"
+#include "byte_count.h"
+#include "baseline/baseline.h"
+#include "../test.h"
+
+// bytes copied or formatted for one Enter, from the input line to the
+// scrollback, counted by byte_count.c on both paths as they run:
+//   before: the Enter key, calc.c and the hexowl exports of the first commit,
+//           from baseline/, with C.GoString and fmt.Sprintf of its Go side
+//   after:  calc_submit and the calc task, the Go side takes the input in the
+//           request slot without a copy, see HexowlInputBuffer
+// both paths have to leave the same text in their scrollback
+
+static volatile int done;
+
+static void on_event(calc_ticket_t ticket, calc_event_t event, const char *str)
+{
+    if (event == CALC_EVENT_DONE)
+        done = 1;
+}
+
+static size_t measure_before(const char *input)
+{
+    size_t bytes;
+
+    byte_count = 0;
+    byte_count_on = true;
+    baseline_enter(input);
+    byte_count_on = false;
+    bytes = byte_count;
+
+    return bytes;
+}
+
+static size_t measure_after(const char *input)
+{
+    size_t bytes;
+
+    harness_clear_output();
+    done = 0;
+
+    byte_count = 0;
+    byte_count_on = true;
+    CHECK(calc_submit(input, on_event) != 0);
+    while (!done)
+        vTaskDelay(1);
+    byte_count_on = false;
+    bytes = byte_count;
+
+    return bytes;
+}
+
+static void measure(const char *input)
+{
+    harness_output_t *out = malloc(sizeof(harness_output_t));
+    size_t before = measure_before(input);
+    size_t after = measure_after(input);
+
+    harness_output(out);
+    CHECK(strcmp(out->text, baseline_scrollback()) == 0);
+
+    printf("%4u char input: before %5u bytes, after %5u, %.2fx\n",
+           (unsigned)strlen(input), (unsigned)before, (unsigned)after, (double)before / after);
+    CHECK(after < before);
+
+    free(out);
+}
+
+int main(void)
+{
+    char long_input[201];
+
+    memset(long_input, 'x', 199);
+    long_input[199] = '7';
+    long_input[200] = '\0';
+
+    harness_start();
+    baseline_start();
+    measure("v7");
+    measure("x + 0xFFFF_FFFF & mask 4294967295");
+    measure(long_input);
+    measure("undefined");
+    return test_failures;
+}
@@ -0,0 +1,303 @@
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#include "calc_harness.h"
+#include "fake_hexowl.h"
+#include "../test.h"
+
+// period of the key scan in keyboard.c, a key callback must return within it
+#define SCAN_PERIOD_MS  (5)
+#define SCAN_PERIOD_US  (SCAN_PERIOD_MS * 1000)
+#define BURST_LEN       (200)
+#define MAX_TICKETS     (256)
+
+typedef struct {
+    calc_ticket_t ticket;
+    char input[16];
+    int begins;
+    int dones;
+    int order;
+} submitted_t;
+
+// the calc task may report a request before calc_submit returned its ticket
+static pthread_mutex_t submit_lock = PTHREAD_MUTEX_INITIALIZER;
+static submitted_t submitted[MAX_TICKETS];
+static volatile int submitted_count;
+static volatile int events_count;
+static volatile int done_count;
+
+static submitted_t *find(calc_ticket_t ticket)
+{
+    for (int i = 0; i < submitted_count; ++i)
+    {
+        if (submitted[i].ticket == ticket)
+            return &submitted[i];
+    }
+    return NULL;
+}
+
+static void on_event(calc_ticket_t ticket, calc_event_t event, const char *str)
+{
+    submitted_t *s;
+
+    pthread_mutex_lock(&submit_lock);
+    s = find(ticket);
+    pthread_mutex_unlock(&submit_lock);
+
+    CHECK(s != NULL);
+    if (s == NULL)
+        return;
+
+    if (event == CALC_EVENT_BEGIN)
+    {
+        CHECK(str != NULL && strcmp(str, s->input) == 0);
+        CHECK(s->begins == 0 && s->dones == 0);
+        ++s->begins;
+        s->order = events_count++;
+    }
+    else if (event == CALC_EVENT_DONE)
+    {
+        CHECK(s->begins == 1 && s->dones == 0);
+        ++s->dones;
+        ++done_count;
+    }
+}
+
+static void on_preview(const char *result)
+{
+}
+
+static bool submit(const char *input)
+{
+    submitted_t *s = &submitted[submitted_count];
+    bool ok;
+
+    pthread_mutex_lock(&submit_lock);
+    snprintf(s->input, sizeof(s->input), "%s", input);
+    s->ticket = calc_submit(s->input, on_event);
+    ok = s->ticket != 0;
+    if (ok)
+        ++submitted_count;
+    pthread_mutex_unlock(&submit_lock);
+
+    return ok;
+}
+
+static void wait_done(int timeout_ms)
+{
+    for (int ms = 0; ms < timeout_ms && done_count < submitted_count; ++ms)
+        vTaskDelay(1);
+}
+
+// a key scan: the edited line is previewed on every key and submitted on Enter,
+// as the calc screen does it from the keyboard task
+static int64_t scan(int key, bool *accepted, bool *busy)
+{
+    char input[16];
+    int64_t begin = harness_now_us();
+
+    snprintf(input, sizeof(input), "v%d", key);
+    calc_preview(input, on_preview);
+    if (key % 10 == 9)
+        *accepted = submit(input);
+    else
+        *accepted = false;
+    *busy = fake_hexowl_busy;
+
+    return harness_now_us() - begin;
+}
+
+// while a long evaluation runs, the keyboard task types a burst of keys and
+// presses Enter on every tenth: no scan may be held up, every accepted
+// request completes once and in order, and a full queue is reported at once
+static void test_burst_during_evaluation(void)
+{
+    int64_t begin, slowest = 0;
+    int accepted = 0, rejected = 0, scans_during = 0;
+    harness_output_t *out = malloc(sizeof(harness_output_t));
+
+    fake_hexowl_slow_ms = 1500;
+    CHECK(submit("slow1"));
+    while (!fake_hexowl_busy)
+        vTaskDelay(1);
+
+    begin = harness_now_us();
+    for (int key = 0; key < BURST_LEN; ++key)
+    {
+        bool ok, busy;
+        int64_t t = scan(key, &ok, &busy);
+
+        if (t > slowest)
+            slowest = t;
+        if (key % 10 == 9)
+            ok ? ++accepted : ++rejected;
+        if (busy)
+            ++scans_during;
+
+        // the next scan is due one period after this one began
+        int64_t next = begin + (int64_t)(key + 1) * SCAN_PERIOD_US - harness_now_us();
+        if (next > 0)
+            vTaskDelay((next + 999) / 1000);
+    }
+
+    printf("burst: %d scans, %d during the evaluation, slowest key callback %lld us, "
+           "%d submits accepted, %d refused as busy\n",
+           BURST_LEN, scans_during, (long long)slowest, accepted, rejected);
+
+    CHECK(slowest < SCAN_PERIOD_US);
+    CHECK(scans_during > BURST_LEN / 2);
+    // the slow request holds a slot, the others fill the rest of the queue
+    CHECK(accepted == CALC_QUEUE_DEPTH - 1);
+    CHECK(rejected == BURST_LEN / 10 - accepted);
+
+    wait_done(5000);
+    CHECK(done_count == submitted_count);
+
+    harness_output(out);
+    for (int i = 0; i < submitted_count; ++i)
+    {
+        char echo[32];
+
+        CHECK(submitted[i].begins == 1 && submitted[i].dones == 1);
+        CHECK(submitted[i].order == i);
+
+        snprintf(echo, sizeof(echo), ">: %s\n", submitted[i].input);
+        CHECK(strstr(out->text, echo) != NULL);
+    }
+    free(out);
+}
+
+// back to back submits without a pause: a refused one is retried like a user
+// pressing Enter again, none may get lost and every result has to show up
+static void test_back_to_back(void)
+{
+    int first = submitted_count, retries = 0;
+    harness_output_t *out = malloc(sizeof(harness_output_t));
+    const char *p;
+
+    harness_clear_output();
+    for (int i = 0; i < 100; ++i)
+    {
+        char input[16];
+
+        snprintf(input, sizeof(input), "n%d", 1000 + i);
+        while (!submit(input))
+        {
+            ++retries;
+            vTaskDelay(1);
+        }
+    }
+
+    wait_done(5000);
+    CHECK(done_count == submitted_count);
+    printf("back to back: 100 submits, %d retries on a full queue\n", retries);
+
+    harness_output(out);
+    p = out->text;
+    for (int i = first; i < submitted_count; ++i)
+    {
+        char result[32];
+
+        CHECK(submitted[i].order == i);
+
+        // the results are in the submit order
+        snprintf(result, sizeof(result), "<: %d\n", 1000 + i - first);
+        p = strstr(p, result);
+        CHECK(p != NULL);
+        if (p == NULL)
+            break;
+    }
+    free(out);
+}
+
+static volatile bool batch_done;
+
+static void on_batch_event(calc_ticket_t ticket, calc_event_t event, const char *str)
+{
+    if (event == CALC_EVENT_DONE)
+        batch_done = true;
+}
+
+// a batch longer than the input buffer keeps its whole lines only,
+// the cut line would otherwise be evaluated as a shorter expression
+static void test_long_batch(void)
+{
+    static char batch[1200 + 1];
+    harness_output_t *out = malloc(sizeof(harness_output_t));
+    int len = 0;
+
+    // 200 lines of 6 bytes, the buffer of 1024 holds 170 of them and "n117"
+    for (int i = 0; i < 200; ++i)
+        len += snprintf(&batch[len], sizeof(batch) - len, "n%d\n", 1000 + i);
+
+    harness_clear_output();
+    batch_done = false;
+    CHECK(calc_submit(batch, on_batch_event) != 0);
+    for (int ms = 0; ms < 5000 && !batch_done; ++ms)
+        vTaskDelay(1);
+    CHECK(batch_done);
+
+    harness_output(out);
+    CHECK(strstr(out->text, ">: n1169\n<: 1169\n") != NULL);
+    CHECK(strstr(out->text, ">: n1170\n") == NULL);
+    CHECK(strstr(out->text, ">: n117\n") == NULL);
+    free(out);
+}
+
+static volatile int rejected_errors;
+
+static void on_rejected_event(calc_ticket_t ticket, calc_event_t event, const char *str)
+{
+    CHECK(event != CALC_EVENT_BEGIN);
+    if (event == CALC_EVENT_ERROR)
+    {
+        CHECK(str != NULL && strstr(str, "longer") != NULL);
+        ++rejected_errors;
+    }
+    else if (event == CALC_EVENT_DONE)
+    {
+        CHECK(rejected_errors == 1);
+        batch_done = true;
+    }
+}
+
+// a line over the input buffer is rejected, not evaluated as its first 1024 bytes;
+// a batch starting with one has no whole line to keep
+static void test_long_line(const char *first_line_end)
+{
+    static char input[1100 + 8];
+    harness_output_t *out = malloc(sizeof(harness_output_t));
+    uint32_t calls = fake_hexowl_calls;
+
+    memset(input, 'x', 1100);
+    snprintf(&input[1100], sizeof(input) - 1100, "7%s", first_line_end);
+
+    harness_clear_output();
+    rejected_errors = 0;
+    batch_done = false;
+    CHECK(calc_submit(input, on_rejected_event) != 0);
+    for (int ms = 0; ms < 5000 && !batch_done; ++ms)
+        vTaskDelay(1);
+    CHECK(batch_done);
+    CHECK(fake_hexowl_calls == calls);
+
+    harness_output(out);
+    CHECK(strcmp(out->text, "<: error: input is longer than 1024 bytes\n") == 0);
+    free(out);
+}
+
+int main(void)
+{
+    harness_start();
+    test_burst_during_evaluation();
+    test_back_to_back();
+    test_long_batch();
+    test_long_line("");
+    test_long_line("\nn5\n");
+    return test_failures;
+}
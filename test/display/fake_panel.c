@@ -0,0 +1,54 @@
+#include "fake_panel.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+uint8_t fake_panel_ram[FAKE_PANEL_ROWS][FAKE_PANEL_COLUMNS * 2];
+uint32_t fake_panel_windows;
+
+panel_t *panel_init(spi_host_device_t host, panel_pinmap_t pinmap, uint8_t column_offset)
+{
+    panel_t *panel = calloc(1, sizeof(panel_t));
+    if (panel == NULL)
+    {
+        return NULL;
+    }
+
+    (void)host;
+    panel->pinmap = pinmap;
+    panel->column_offset = column_offset;
+    return panel;
+}
+
+void panel_deinit(panel_t *panel)
+{
+    free(panel);
+}
+
+void panel_wait(panel_t *panel)
+{
+    panel->pending = false;
+}
+
+// the controller fills the window row by row, two bytes per column
+uint32_t panel_write_window(panel_t *panel, int col0, int col1, int row0, int row1, const uint8_t *data, size_t len)
+{
+    int w = (col1 - col0 + 1) * 2;
+
+    // the window must be filled exactly, or the next one starts misplaced
+    if (len != (size_t)w * (row1 - row0 + 1))
+    {
+        abort();
+    }
+
+    panel_wait(panel);
+
+    for (int y = row0; y <= row1; ++y)
+    {
+        memcpy(&fake_panel_ram[y][(panel->column_offset + col0) * 2], &data[(y - row0) * w], w);
+    }
+
+    ++fake_panel_windows;
+    panel->pending = true;
+    return 7 + len;
+}
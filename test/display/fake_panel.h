@@ -0,0 +1,11 @@
+#pragma once
+
+#include <panel/panel.h>
+
+// RAM of the SSD1322, 480 x 128 pixels in columns of 4
+#define FAKE_PANEL_COLUMNS  (120)
+#define FAKE_PANEL_ROWS     (128)
+
+extern uint8_t fake_panel_ram[FAKE_PANEL_ROWS][FAKE_PANEL_COLUMNS * 2];
+// windows written since the start
+extern uint32_t fake_panel_windows;
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <fonts/cascadia_font.h>
+
+// the layout of the generated unpacked font, as declared in cascadia_font.c:
+// every glyph is a w x h bitmap of 4bpp pixels, the left one in the high nibble
+typedef struct {
+    const unsigned char *bitmap;
+    unsigned char w;
+    unsigned char h;
+} ref_font_char_t;
+
+typedef struct {
+    const ref_font_char_t *chars;
+    unsigned char first_index;
+    unsigned char last_index;
+} ref_font_t;
+
+static inline const ref_font_char_t *ref_font_char(unsigned char c)
+{
+    const ref_font_t *font = cascadia_font;
+    return &font->chars[c];
+}
+
+static inline uint8_t ref_font_pixel(const ref_font_char_t *ch, int x, int y)
+{
+    uint8_t b = ch->bitmap[y * ((ch->w + 1) / 2) + x / 2];
+    return (x % 2) ? b & 0x0F : b >> 4;
+}
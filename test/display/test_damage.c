@@ -0,0 +1,151 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include <damage/damage.h>
+#include <text/text.h>
+#include <fonts/cascadia_pack.h>
+
+#include "fake_panel.h"
+#include "../test.h"
+
+#define RES_X           (256)
+#define RES_Y           (64)
+#define STRIDE          (RES_X / 2)
+#define COLUMN_OFFSET   (0x1C)
+// the bytes a keystroke may move, an eighth of a full frame
+#define KEYSTROKE_MAX   (1024)
+
+static uint8_t framebuffer[RES_X * RES_Y / 2];
+static ssd1322_t display = {
+    .res_x = RES_X,
+    .res_y = RES_Y,
+    .framebuffer = framebuffer,
+};
+
+static bool panel_shows_framebuffer(void)
+{
+    for (int y = 0; y < RES_Y; ++y)
+    {
+        if (memcmp(&fake_panel_ram[y][COLUMN_OFFSET * 2], &framebuffer[y * STRIDE], STRIDE) != 0)
+            return false;
+    }
+    return true;
+}
+
+static void set_pixel(int x, int y, uint8_t color)
+{
+    uint8_t *p = &framebuffer[y * STRIDE + x / 2];
+    *p = (x % 2) ? (*p & 0xF0) | color : (*p & 0x0F) | (color << 4);
+}
+
+// the input line of the calc screen: cleared, the text and the cursor under it
+static void draw_input(const char *str)
+{
+    int cursor = strlen(str);
+
+    memset(&framebuffer[(RES_Y - 14) * STRIDE], 0, 14 * STRIDE);
+    text_draw_string(&display, 4, RES_Y - 14, str, &cascadia_pack);
+    for (int x = 4 + cursor * 8; x < 12 + cursor * 8; ++x)
+        set_pixel(x, RES_Y - 1, 3);
+}
+
+// the bytes the two simple plans would send: a window per dirty row and one over all of them
+static void simple_costs(const uint8_t *sent, uint32_t *per_row, uint32_t *bounding)
+{
+    int top = -1, bottom = 0, left = STRIDE, right = -1;
+
+    *per_row = 0;
+    for (int y = 0; y < RES_Y; ++y)
+    {
+        const uint8_t *a = &framebuffer[y * STRIDE], *b = &sent[y * STRIDE];
+        int l = 0, r = STRIDE - 1;
+
+        if (memcmp(a, b, STRIDE) == 0)
+            continue;
+
+        while (a[l] == b[l]) ++l;
+        while (a[r] == b[r]) --r;
+        l -= l % 2;
+        r += 1 - r % 2;
+
+        *per_row += 7 + r - l + 1;
+        if (top < 0) top = y;
+        bottom = y;
+        if (l < left) left = l;
+        if (r > right) right = r;
+    }
+
+    *bounding = (top < 0) ? 0 : 7 + (right - left + 1) * (bottom - top + 1);
+}
+
+static void test_full_first_flush(damage_t *dmg)
+{
+    for (size_t i = 0; i < sizeof(framebuffer); ++i)
+        framebuffer[i] = rand();
+
+    CHECK(damage_flush(dmg) == 7 + sizeof(framebuffer));
+    CHECK(panel_shows_framebuffer());
+    CHECK(damage_flush(dmg) == 0);
+}
+
+static void test_random_frames(damage_t *dmg)
+{
+    static uint8_t sent[sizeof(framebuffer)];
+
+    for (int frame = 0; frame < 5000; ++frame)
+    {
+        uint32_t per_row, bounding, bytes;
+
+        memcpy(sent, framebuffer, sizeof(framebuffer));
+        for (int n = rand() % 8; n > 0; --n)
+        {
+            // mostly short runs, like glyphs and lines
+            int y = rand() % RES_Y, x = rand() % STRIDE, len = 1 + rand() % 6;
+            for (int i = x; i < x + len && i < STRIDE; ++i)
+                framebuffer[y * STRIDE + i] = rand();
+        }
+
+        simple_costs(sent, &per_row, &bounding);
+        bytes = damage_flush(dmg);
+
+        CHECK(panel_shows_framebuffer());
+        CHECK(bytes <= per_row);
+        CHECK(bytes <= bounding);
+    }
+}
+
+static void test_keystroke(damage_t *dmg)
+{
+    uint32_t windows, bytes;
+
+    memset(framebuffer, 0, sizeof(framebuffer));
+    draw_input("0x1F + 4");
+    damage_flush(dmg);
+
+    windows = fake_panel_windows;
+    draw_input("0x1F + 42");
+    bytes = damage_flush(dmg);
+
+    printf("keystroke: %u bytes in %u windows, a full frame is %u\n",
+           (unsigned)bytes, (unsigned)(fake_panel_windows - windows), (unsigned)(7 + sizeof(framebuffer)));
+    CHECK(panel_shows_framebuffer());
+    CHECK(bytes > 0);
+    CHECK(bytes < KEYSTROKE_MAX);
+}
+
+int main(void)
+{
+    panel_pinmap_t pinmap = {.dc = 21, .cs = 5};
+    panel_t *panel = panel_init(0, pinmap, COLUMN_OFFSET);
+    damage_t *dmg = damage_init(&display, panel);
+
+    srand(1);
+    CHECK(dmg != NULL);
+    test_full_first_flush(dmg);
+    test_random_frames(dmg);
+    test_keystroke(dmg);
+
+    damage_deinit(dmg);
+    panel_deinit(panel);
+    return test_failures;
+}
@@ -0,0 +1,68 @@
+#include <fonts/font_pack.h>
+#include <fonts/cascadia_pack.h>
+
+#include "ref_font.h"
+#include "../test.h"
+
+static uint8_t pack_pixel(const font_pack_glyph_t *g, int x, int y)
+{
+    const uint8_t *row = font_pack_row(&cascadia_pack, g, y);
+
+    x -= g->left;
+    if (row == NULL || x < 0 || x >= g->bytes * 2)
+        return 0;
+
+    return (x % 2) ? row[x / 2] & 0x0F : row[x / 2] >> 4;
+}
+
+// every pixel of the packed font decodes to the one of the font it was made from
+static void test_round_trip(void)
+{
+    size_t packed = 0, unpacked = 0;
+
+    for (int c = cascadia_pack.first; c <= cascadia_pack.last; ++c)
+    {
+        const font_pack_glyph_t *g = font_pack_glyph(&cascadia_pack, c);
+        const ref_font_char_t *ch = ref_font_char(c);
+        int bad = 0;
+
+        CHECK(g->w == ch->w && g->h == ch->h);
+        CHECK(g->left % 2 == 0);
+        CHECK(g->rows <= 16 && g->top + g->rows <= g->h);
+
+        for (int y = 0; y < ch->h; ++y)
+        {
+            for (int x = 0; x < ch->w; ++x)
+            {
+                if (pack_pixel(g, x, y) != ref_font_pixel(ch, x, y))
+                    ++bad;
+            }
+        }
+
+        if (bad != 0)
+            fprintf(stderr, "'%c': %d pixels differ\n", c, bad);
+        CHECK(bad == 0);
+
+        packed += __builtin_popcount(g->row_mask) * g->bytes + sizeof(font_pack_glyph_t);
+        unpacked += ch->h * ((ch->w + 1) / 2) + sizeof(ref_font_char_t);
+    }
+
+    printf("printable chars: packed %u bytes, unpacked %u bytes\n", (unsigned)packed, (unsigned)unpacked);
+}
+
+// chars out of the font are drawn as a space
+static void test_out_of_range(void)
+{
+    const font_pack_glyph_t *space = font_pack_glyph(&cascadia_pack, ' ');
+
+    CHECK(font_pack_glyph(&cascadia_pack, '\t') == space);
+    CHECK(font_pack_glyph(&cascadia_pack, (char)0x7F) == space);
+    CHECK(font_pack_glyph(&cascadia_pack, (char)0xC8) == space);
+}
+
+int main(void)
+{
+    test_round_trip();
+    test_out_of_range();
+    return test_failures;
+}
@@ -0,0 +1,132 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <text/text.h>
+#include <fonts/cascadia_pack.h>
+
+#include "ref_font.h"
+#include "../test.h"
+
+#define RES_X       (256)
+#define RES_Y       (64)
+#define STRIDE      (RES_X / 2)
+#define BENCH_RUNS  (20000)
+
+static uint8_t framebuffer[RES_X * RES_Y / 2];
+static uint8_t expected[RES_X * RES_Y / 2];
+static ssd1322_t display = {
+    .res_x = RES_X,
+    .res_y = RES_Y,
+    .framebuffer = framebuffer,
+};
+
+// the reference: every set pixel of the unpacked font on its own
+static void ref_draw_string(uint8_t *fb, int x, int y, const char *str)
+{
+    for (; *str != '\0' && *str != '\n'; ++str)
+    {
+        const ref_font_char_t *ch = ref_font_char(*str);
+
+        for (int j = 0; j < ch->h; ++j)
+        {
+            for (int i = 0; i < ch->w; ++i)
+            {
+                int px = x + i, py = y + j;
+                uint8_t c = ref_font_pixel(ch, i, j);
+                uint8_t *p;
+
+                if (c == 0 || px < 0 || py < 0 || px >= RES_X || py >= RES_Y)
+                    continue;
+
+                p = &fb[py * STRIDE + px / 2];
+                *p = (px % 2) ? (*p & 0xF0) | c : (*p & 0x0F) | (c << 4);
+            }
+        }
+        x += ch->w;
+    }
+}
+
+static double now_us(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
+
+// the blitter and the pixel path must draw what the old font did, clipped or not
+static void test_matches_reference(void)
+{
+    static const int xs[] = {0, 4, 8, 3, -3, -8, 250, 251};
+    static const int ys[] = {0, -5, 30, 55, 60, -11};
+    char all[96];
+
+    for (int i = 0; i < 95; ++i)
+        all[i] = ' ' + i;
+    all[95] = '\0';
+
+    for (size_t xi = 0; xi < sizeof(xs) / sizeof(xs[0]); ++xi)
+    {
+        for (size_t yi = 0; yi < sizeof(ys) / sizeof(ys[0]); ++yi)
+        {
+            for (int first = 0; first < 95; first += 32)
+            {
+                char str[33];
+
+                strncpy(str, &all[first], 32);
+                str[32] = '\0';
+
+                memset(framebuffer, 0, sizeof(framebuffer));
+                memset(expected, 0, sizeof(expected));
+                text_draw_string(&display, xs[xi], ys[yi], str, &cascadia_pack);
+                ref_draw_string(expected, xs[xi], ys[yi], str);
+
+                if (memcmp(framebuffer, expected, sizeof(framebuffer)) != 0)
+                    fprintf(stderr, "x %d, y %d, chars from '%c'\n", xs[xi], ys[yi], str[0]);
+                CHECK(memcmp(framebuffer, expected, sizeof(framebuffer)) == 0);
+            }
+        }
+    }
+}
+
+// a full screen of the calc scrollback, 5 lines of 31 chars
+static void bench_screen(void)
+{
+    char line[32];
+    double begin, ref_time, blit_time;
+    volatile uint8_t sink = 0;
+
+    for (int i = 0; i < 31; ++i)
+        line[i] = '!' + i * 3 % 90;
+    line[31] = '\0';
+
+    begin = now_us();
+    for (int n = 0; n < BENCH_RUNS; ++n)
+    {
+        memset(expected, 0, sizeof(expected));
+        for (int r = 0; r < 5; ++r)
+            ref_draw_string(expected, 4, 4 + r * 12, line);
+        sink += expected[n % sizeof(expected)];
+    }
+    ref_time = (now_us() - begin) / BENCH_RUNS;
+
+    begin = now_us();
+    for (int n = 0; n < BENCH_RUNS; ++n)
+    {
+        memset(framebuffer, 0, sizeof(framebuffer));
+        for (int r = 0; r < 5; ++r)
+            text_draw_string(&display, 4, 4 + r * 12, line, &cascadia_pack);
+        sink += framebuffer[n % sizeof(framebuffer)];
+    }
+    blit_time = (now_us() - begin) / BENCH_RUNS;
+
+    printf("screen of 155 chars: per pixel %.2f us, blitter %.2f us (%.1fx)\n",
+           ref_time, blit_time, ref_time / blit_time);
+}
+
+int main(void)
+{
+    test_matches_reference();
+    bench_screen();
+    return test_failures;
+}
@@ -0,0 +1,3 @@
+module hard-hexowl-test
+
+go 1.21
@@ -0,0 +1,126 @@
+// the registration export of hexowl, the SD card builtins, the display and the
+// CPU governor are not on the host
+
+#include "host.h"
+
+#include <string.h>
+#include <hexowl.h>
+
+#include "../../../main/calc/native/filehash.h"
+#include "../../../main/calc/native/native.h"
+#include "../../../main/calc/governor/governor.h"
+#include "../../../main/display/ui.h"
+
+#define HOST_MAX_BUILTINS (16)
+
+_Static_assert(HOST_RESULT_STRING == HEXOWL_RESULT_STRING && HOST_RESULT_BOOL == HEXOWL_RESULT_BOOL &&
+                   HOST_RESULT_UINT == HEXOWL_RESULT_UINT && HOST_RESULT_INT == HEXOWL_RESULT_INT &&
+                   HOST_RESULT_FLOAT == HEXOWL_RESULT_FLOAT,
+               "result kinds of hexowl.h");
+_Static_assert(sizeof(host_value_t) == sizeof(hexowl_value_t) &&
+                   offsetof(host_value_t, raw) == offsetof(hexowl_value_t, raw) &&
+                   offsetof(host_value_t, p) == offsetof(hexowl_value_t, str.p) &&
+                   offsetof(host_value_t, n) == offsetof(hexowl_value_t, str.n),
+               "layout of hexowl_value_t");
+
+static struct {
+    char name[16];
+    hexowl_native_func_t func;
+} registered[HOST_MAX_BUILTINS];
+static int registered_count;
+
+void HexowlRegisterNative(GoString name, GoString args, GoString desc, GoUint8 min_args, GoUint8 max_args, GoUint8 flags, hexowl_native_func_t nativefunc)
+{
+    if (registered_count == HOST_MAX_BUILTINS || name.n >= sizeof(registered[0].name))
+        return;
+
+    memcpy(registered[registered_count].name, name.p, name.n);
+    registered[registered_count].name[name.n] = '\0';
+    registered[registered_count].func = nativefunc;
+    ++registered_count;
+}
+
+host_func_t host_find(const char *name)
+{
+    if (registered_count == 0)
+    {
+        native_register();
+        ui_register_builtins();
+    }
+
+    for (int i = 0; i < registered_count; ++i)
+    {
+        if (strcmp(registered[i].name, name) == 0)
+            return (host_func_t)registered[i].func;
+    }
+
+    return NULL;
+}
+
+uint64_t host_bench(host_func_t func, const uint64_t *vals, int n)
+{
+    host_value_t arg = {.kind = HOST_RESULT_UINT};
+    host_value_t ret;
+    uint64_t sum = 0;
+
+    for (int i = 0; i < n; ++i)
+    {
+        arg.raw = vals[i];
+        func(&arg, 1, &ret);
+        sum += ret.raw;
+    }
+
+    return sum;
+}
+
+static const char *no_sdcard(const struct hexowl_value *args, int argc, struct hexowl_value *ret)
+{
+    return "no SD card on the host";
+}
+
+const char *filehash_crc32(const struct hexowl_value *args, int argc, struct hexowl_value *ret)
+{
+    return no_sdcard(args, argc, ret);
+}
+
+const char *filehash_adler32(const struct hexowl_value *args, int argc, struct hexowl_value *ret)
+{
+    return no_sdcard(args, argc, ret);
+}
+
+const char *filehash_sha256(const struct hexowl_value *args, int argc, struct hexowl_value *ret)
+{
+    return no_sdcard(args, argc, ret);
+}
+
+void filehash_interrupt(void)
+{
+}
+
+void filehash_reset(void)
+{
+}
+
+static int fps = 30;
+
+void ui_set_fps(int val)
+{
+    fps = val;
+}
+
+int ui_get_fps(void)
+{
+    return fps;
+}
+
+static uint32_t decay = 3000;
+
+void governor_set_decay(uint32_t decay_ms)
+{
+    decay = decay_ms;
+}
+
+uint32_t governor_get_decay(void)
+{
+    return decay;
+}
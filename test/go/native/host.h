@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// hexowl.h repeats the cgo prologue, which cgo refuses in a preamble, so the
+// Go side sees the builtins through these copies of its types
+
+#define HOST_RESULT_STRING (2)
+#define HOST_RESULT_BOOL (3)
+#define HOST_RESULT_UINT (4)
+#define HOST_RESULT_INT (5)
+#define HOST_RESULT_FLOAT (6)
+
+// layout of hexowl_value_t
+typedef struct {
+    uint8_t kind;
+    uint64_t raw;
+    const char *p;
+    size_t n;
+} host_value_t;
+
+typedef const char *(*host_func_t)(const host_value_t *args, int argc, host_value_t *ret);
+
+// builtin registered by native_register, NULL if there is none of that name
+host_func_t host_find(const char *name);
+
+// the builtin called once per value the way the interpreter calls it, without cgo
+uint64_t host_bench(host_func_t func, const uint64_t *vals, int n);
@@ -0,0 +1,129 @@
+// Package native runs the C builtins of main/calc/native and of the display on
+// the host behind the same argument marshalling as nativeExec of
+// hexowl/sources/main.go
+package native
+
+// #cgo CFLAGS: -O2 -I${SRCDIR}/../../../hexowl/include -I${SRCDIR}/../../../main/calc -I${SRCDIR}/../../../main/calc/native -I${SRCDIR}/../../../main/display
+// #include <stdlib.h>
+// #include "host.h"
+//
+// static const char *host_call(host_func_t func, const host_value_t *args, int argc, host_value_t *ret)
+// {
+//     return func(args, argc, ret);
+// }
+import "C"
+import (
+	"fmt"
+	"math"
+	"unsafe"
+)
+
+const maxNativeArgs = 4
+
+// Func is a C builtin wrapped as a builtin function of hexowl
+type Func func(args ...interface{}) (interface{}, error)
+
+// the arguments live on the stack of tinygo, cgo does not allow C to see a
+// Go pointer, so the arguments and the strings they point to are kept in C
+// memory of the builtin; a Func is not safe for concurrent use
+type callFrame struct {
+	args *[maxNativeArgs + 1]C.host_value_t
+	text []byte
+}
+
+func (f *callFrame) reserve(size int) {
+	if size > len(f.text) {
+		C.free(unsafe.Pointer(unsafe.SliceData(f.text)))
+		size = max(size, 2*len(f.text), 64)
+		f.text = unsafe.Slice((*byte)(C.malloc(C.size_t(size))), size)
+	}
+}
+
+// Find wraps the builtin registered under name, nil if there is none
+func Find(name string) Func {
+	cname := C.CString(name)
+	defer C.free(unsafe.Pointer(cname))
+
+	nativefunc := C.host_find(cname)
+	if nativefunc == nil {
+		return nil
+	}
+
+	frame := &callFrame{
+		args: (*[maxNativeArgs + 1]C.host_value_t)(C.calloc(maxNativeArgs+1, C.sizeof_host_value_t)),
+	}
+
+	return func(args ...interface{}) (interface{}, error) {
+		cargs := frame.args[:maxNativeArgs]
+		ret := &frame.args[maxNativeArgs]
+
+		if len(args) > maxNativeArgs {
+			return nil, fmt.Errorf("%s: too many arguments", name)
+		}
+
+		size := 0
+		for _, arg := range args {
+			if v, ok := arg.(string); ok {
+				size += len(v)
+			}
+		}
+		frame.reserve(size)
+
+		used := 0
+		for i, arg := range args {
+			switch v := arg.(type) {
+			case uint64:
+				cargs[i].kind = C.HOST_RESULT_UINT
+				cargs[i].raw = C.uint64_t(v)
+			case int64:
+				cargs[i].kind = C.HOST_RESULT_INT
+				cargs[i].raw = C.uint64_t(v)
+			case float64:
+				cargs[i].kind = C.HOST_RESULT_FLOAT
+				cargs[i].raw = C.uint64_t(math.Float64bits(v))
+			case bool:
+				cargs[i].kind = C.HOST_RESULT_BOOL
+				cargs[i].raw = 0
+				if v {
+					cargs[i].raw = 1
+				}
+			case string:
+				copy(frame.text[used:], v)
+				cargs[i].kind = C.HOST_RESULT_STRING
+				cargs[i].p = (*C.char)(unsafe.Pointer(unsafe.SliceData(frame.text[used:])))
+				cargs[i].n = C.size_t(len(v))
+				used += len(v)
+			default:
+				return nil, fmt.Errorf("%s: unsupported argument type %T", name, arg)
+			}
+		}
+
+		if msg := C.host_call(nativefunc, &cargs[0], C.int(len(args)), ret); msg != nil {
+			return nil, fmt.Errorf("%s: %s", name, C.GoString(msg))
+		}
+
+		switch ret.kind {
+		case C.HOST_RESULT_UINT:
+			return uint64(ret.raw), nil
+		case C.HOST_RESULT_INT:
+			return int64(ret.raw), nil
+		case C.HOST_RESULT_FLOAT:
+			return math.Float64frombits(uint64(ret.raw)), nil
+		case C.HOST_RESULT_BOOL:
+			return ret.raw != 0, nil
+		case C.HOST_RESULT_STRING:
+			return C.GoStringN(ret.p, C.int(ret.n)), nil
+		}
+
+		return nil, nil
+	}
+}
+
+// Bench calls the popcnt builtin once per value in a C loop, no marshalling
+// and no cgo call in between
+func Bench(vals []uint64) uint64 {
+	cname := C.CString("popcnt")
+	defer C.free(unsafe.Pointer(cname))
+
+	return uint64(C.host_bench(C.host_find(cname), (*C.uint64_t)(unsafe.Pointer(&vals[0])), C.int(len(vals))))
+}
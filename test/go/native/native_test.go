@@ -0,0 +1,211 @@
+package native
+
+import (
+	"encoding/binary"
+	"hash/crc32"
+	"math"
+	"math/bits"
+	"math/rand"
+	"testing"
+)
+
+func find(t testing.TB, name string) Func {
+	f := Find(name)
+	if f == nil {
+		t.Fatalf("%s is not registered", name)
+	}
+	return f
+}
+
+func call(t testing.TB, name string, args ...interface{}) interface{} {
+	ret, err := find(t, name)(args...)
+	if err != nil {
+		t.Fatalf("%s%v: %v", name, args, err)
+	}
+	return ret
+}
+
+func testValues(n int) []uint64 {
+	r := rand.New(rand.NewSource(3))
+	vals := []uint64{0, 1, 0x80, math.MaxUint32, math.MaxInt64, math.MaxUint64}
+	for len(vals) < n {
+		vals = append(vals, r.Uint64()>>uint(r.Intn(64)))
+	}
+	return vals
+}
+
+// CRC-16/CCITT-FALSE bit by bit, the Go library has no CRC-16
+func crc16(data []byte) uint64 {
+	crc := uint16(0xFFFF)
+	for _, b := range data {
+		crc ^= uint16(b) << 8
+		for i := 0; i < 8; i++ {
+			if crc&0x8000 != 0 {
+				crc = crc<<1 ^ 0x1021
+			} else {
+				crc <<= 1
+			}
+		}
+	}
+	return uint64(crc)
+}
+
+func TestMatchesGo(t *testing.T) {
+	var le [8]byte
+
+	for _, v := range testValues(20000) {
+		binary.LittleEndian.PutUint64(le[:], v)
+		f := math.Float64frombits(v)
+
+		checks := []struct {
+			name string
+			args []interface{}
+			want interface{}
+		}{
+			{"popcnt", []interface{}{v}, uint64(bits.OnesCount64(v))},
+			{"popcnt", []interface{}{int64(v)}, uint64(bits.OnesCount64(v))},
+			{"bitrev", []interface{}{v}, bits.Reverse64(v)},
+			{"bitrev", []interface{}{v, uint64(12)}, bits.Reverse64(v) >> 52},
+			{"bswap", []interface{}{v}, bits.ReverseBytes64(v)},
+			{"bswap", []interface{}{v, uint64(2)}, uint64(bits.ReverseBytes16(uint16(v)))},
+			{"crc32", []interface{}{v}, uint64(crc32.ChecksumIEEE(le[:4]))},
+			{"crc32", []interface{}{v, uint64(8)}, uint64(crc32.ChecksumIEEE(le[:]))},
+			{"crc16", []interface{}{v, uint64(8)}, crc16(le[:])},
+			{"bitsf32", []interface{}{v & math.MaxUint32}, float64(math.Float32frombits(uint32(v)))},
+		}
+		if !math.IsNaN(f) {
+			checks = append(checks, []struct {
+				name string
+				args []interface{}
+				want interface{}
+			}{
+				{"bitsf64", []interface{}{v}, f},
+				{"f64bits", []interface{}{f}, v},
+				{"f32bits", []interface{}{f}, uint64(math.Float32bits(float32(f)))},
+			}...)
+		}
+
+		for _, c := range checks {
+			got := call(t, c.name, c.args...)
+			if g, ok := got.(float64); ok && math.IsNaN(g) && math.IsNaN(c.want.(float64)) {
+				continue
+			}
+			if got != c.want {
+				t.Fatalf("%s%v: got %v, want %v", c.name, c.args, got, c.want)
+			}
+		}
+	}
+
+	// the check values of the catalogue of CRC algorithms
+	if got := call(t, "crc32", "123456789"); got != uint64(0xCBF43926) {
+		t.Fatalf("crc32: got %#x", got)
+	}
+	if got := call(t, "crc16", "123456789"); got != uint64(0x29B1) {
+		t.Fatalf("crc16: got %#x", got)
+	}
+	if got := call(t, "crc32", ""); got != uint64(0) {
+		t.Fatalf("crc32 of nothing: got %#x", got)
+	}
+}
+
+func TestErrors(t *testing.T) {
+	checks := []struct {
+		name string
+		args []interface{}
+	}{
+		{"popcnt", []interface{}{"text"}},
+		{"bitrev", []interface{}{uint64(1), uint64(0)}},
+		{"bitrev", []interface{}{uint64(1), uint64(65)}},
+		{"bswap", []interface{}{uint64(1), uint64(9)}},
+		{"crc32", []interface{}{"text", uint64(4)}},
+		{"bitsf32", []interface{}{uint64(math.MaxUint32 + 1)}},
+		{"crc32f", []interface{}{"file"}},
+		{"fps", []interface{}{uint64(1001)}},
+		{"fps", []interface{}{"fast"}},
+		{"boost", []interface{}{uint64(60001)}},
+	}
+
+	for _, c := range checks {
+		if _, err := find(t, c.name)(c.args...); err == nil {
+			t.Errorf("%s%v: no error", c.name, c.args)
+		}
+	}
+}
+
+// the cap of the display frames, changed or read
+func TestFps(t *testing.T) {
+	if got := call(t, "fps", uint64(60)); got != uint64(60) {
+		t.Fatalf("fps(60): got %v", got)
+	}
+	if got := call(t, "fps"); got != uint64(60) {
+		t.Fatalf("fps(): got %v", got)
+	}
+	if got := call(t, "fps", int64(0)); got != uint64(0) {
+		t.Fatalf("fps(0): got %v", got)
+	}
+}
+
+// the boost decay of the CPU governor, changed or read
+func TestBoost(t *testing.T) {
+	if got := call(t, "boost", uint64(500)); got != uint64(500) {
+		t.Fatalf("boost(500): got %v", got)
+	}
+	if got := call(t, "boost"); got != uint64(500) {
+		t.Fatalf("boost(): got %v", got)
+	}
+}
+
+// the builtins as they would be written in Go, called through a Func like
+// the interpreter calls them
+var popcntGo Func = func(args ...interface{}) (interface{}, error) {
+	return uint64(bits.OnesCount64(args[0].(uint64))), nil
+}
+
+var crc32Go Func = func(args ...interface{}) (interface{}, error) {
+	return uint64(crc32.ChecksumIEEE([]byte(args[0].(string)))), nil
+}
+
+// the whole call of a builtin from the interpreter: marshalling, the cgo
+// boundary and the C function
+
+func BenchmarkPopcntNative(b *testing.B) {
+	popcnt := find(b, "popcnt")
+	vals := testValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		popcnt(vals[i%len(vals)])
+	}
+}
+
+func BenchmarkPopcntGo(b *testing.B) {
+	vals := testValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		popcntGo(vals[i%len(vals)])
+	}
+}
+
+// the C function alone, the difference to BenchmarkPopcntNative is the cost
+// of the boundary
+func BenchmarkPopcntC(b *testing.B) {
+	vals := testValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += len(vals) {
+		Bench(vals[:min(len(vals), b.N-i)])
+	}
+}
+
+var text = "the quick brown fox jumps over the lazy dog, 0123456789ABCDEF"
+
+func BenchmarkCrc32Native(b *testing.B) {
+	crc := find(b, "crc32")
+	for i := 0; i < b.N; i++ {
+		crc(text)
+	}
+}
+
+func BenchmarkCrc32Go(b *testing.B) {
+	for i := 0; i < b.N; i++ {
+		crc32Go(text)
+	}
+}
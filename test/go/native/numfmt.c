@@ -0,0 +1,2 @@
+// cgo builds only the C files of the package directory
+#include "../../../main/calc/format/numfmt.c"
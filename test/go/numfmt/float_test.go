@@ -0,0 +1,77 @@
+package numfmt
+
+import (
+	"fmt"
+	"math"
+	"math/rand"
+	"testing"
+)
+
+// bit patterns cover every exponent, the subnormals and NaN, the decimal
+// fractions are the results people type in
+func floatValues(n int) []float64 {
+	r := rand.New(rand.NewSource(2))
+	vals := []float64{
+		0, math.Copysign(0, -1), 1, -1, 0.1, 0.2 + 0.1, 1.0 / 3, 2.5, 1e-4, 9.9999e-5,
+		1e-5, 123456, 999999, 1e6, 1e21, 5e-324, math.SmallestNonzeroFloat64,
+		math.MaxFloat64, math.Inf(1), math.Inf(-1), math.NaN(),
+		math.Nextafter(1, 2), math.Nextafter(1e6, 0), 1 << 53, 1<<53 + 2,
+	}
+	for len(vals) < n {
+		switch r.Intn(3) {
+		case 0:
+			vals = append(vals, math.Float64frombits(r.Uint64()))
+		case 1:
+			vals = append(vals, float64(r.Int63n(1e9)-5e8)/math.Pow10(r.Intn(12)))
+		default:
+			vals = append(vals, r.NormFloat64()*math.Pow10(r.Intn(40)-20))
+		}
+	}
+	return vals
+}
+
+// numfmt_float takes over the %v of Go for float results
+func TestFloatMatchesFmt(t *testing.T) {
+	for _, v := range floatValues(2000000) {
+		if got, want := Float(v), fmt.Sprintf("%v", v); got != want {
+			t.Fatalf("%#016x: got %q, want %q", math.Float64bits(v), got, want)
+		}
+	}
+}
+
+// the integer bits of a float result, shown in hex and binary
+func TestFloatInt(t *testing.T) {
+	for _, v := range floatValues(200000) {
+		var want uint64
+		switch {
+		case math.IsNaN(v):
+		case v >= math.MaxUint64:
+			want = math.MaxUint64
+		case v < math.MinInt64:
+			want = 1 << 63
+		case v < 0:
+			want = uint64(int64(v))
+		default:
+			want = uint64(v)
+		}
+		if got := FloatInt(v); got != want {
+			t.Fatalf("%v: got %#x, want %#x", v, got, want)
+		}
+	}
+}
+
+func BenchmarkFloatC(b *testing.B) {
+	vals := floatValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += len(vals) {
+		BenchFloat(vals[:min(len(vals), b.N-i)])
+	}
+}
+
+func BenchmarkFloatGoSprintf(b *testing.B) {
+	vals := floatValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		_ = fmt.Sprintf("%v", vals[i%len(vals)])
+	}
+}
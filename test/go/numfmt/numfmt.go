@@ -0,0 +1,98 @@
+// Package numfmt runs the result formatters of main/calc/format on the host,
+// so they can be checked against fmt and timed against it
+package numfmt
+
+// #cgo CFLAGS: -O2 -I${SRCDIR}/../../../main/calc/format
+// #include <numfmt.h>
+//
+// // every value of vals formatted in a row, as many times as a benchmark asks
+// static int bench_udec(const uint64_t *vals, int n)
+// {
+//     char buf[NUMFMT_MAX_LEN];
+//     int len = 0;
+//     for (int i = 0; i < n; ++i)
+//         len += numfmt_udec(buf, vals[i]);
+//     return len;
+// }
+//
+// static int bench_hex(const uint64_t *vals, int n)
+// {
+//     char buf[NUMFMT_MAX_LEN];
+//     int len = 0;
+//     for (int i = 0; i < n; ++i)
+//         len += numfmt_hex(buf, vals[i]);
+//     return len;
+// }
+//
+// static int bench_bin(const uint64_t *vals, int n)
+// {
+//     char buf[NUMFMT_MAX_LEN];
+//     int len = 0;
+//     for (int i = 0; i < n; ++i)
+//         len += numfmt_bin(buf, vals[i], 0);
+//     return len;
+// }
+//
+// static int bench_float(const double *vals, int n)
+// {
+//     char buf[NUMFMT_MAX_LEN];
+//     int len = 0;
+//     for (int i = 0; i < n; ++i)
+//         len += numfmt_float(buf, vals[i]);
+//     return len;
+// }
+import "C"
+import "unsafe"
+
+func format(f func(buf *C.char) C.int) string {
+	var buf [C.NUMFMT_MAX_LEN]C.char
+	n := f(&buf[0])
+	return C.GoStringN(&buf[0], n)
+}
+
+func Udec(v uint64) string {
+	return format(func(buf *C.char) C.int { return C.numfmt_udec(buf, C.uint64_t(v)) })
+}
+
+func Dec(v int64) string {
+	return format(func(buf *C.char) C.int { return C.numfmt_dec(buf, C.int64_t(v)) })
+}
+
+func Hex(v uint64) string {
+	return format(func(buf *C.char) C.int { return C.numfmt_hex(buf, C.uint64_t(v)) })
+}
+
+func Bin(v uint64, group int) string {
+	return format(func(buf *C.char) C.int { return C.numfmt_bin(buf, C.uint64_t(v), C.int(group)) })
+}
+
+func Float(v float64) string {
+	return format(func(buf *C.char) C.int { return C.numfmt_float(buf, C.double(v)) })
+}
+
+func FloatInt(v float64) uint64 {
+	return uint64(C.numfmt_float_int(C.double(v)))
+}
+
+// the loops run in C, so a benchmark times the formatter and not the cgo calls
+func loop(f func(vals *C.uint64_t, n C.int) C.int, vals []uint64) int {
+	return int(f((*C.uint64_t)(unsafe.Pointer(&vals[0])), C.int(len(vals))))
+}
+
+func BenchUdec(vals []uint64) int {
+	return loop(func(v *C.uint64_t, n C.int) C.int { return C.bench_udec(v, n) }, vals)
+}
+
+func BenchHex(vals []uint64) int {
+	return loop(func(v *C.uint64_t, n C.int) C.int { return C.bench_hex(v, n) }, vals)
+}
+
+func BenchBin(vals []uint64) int {
+	return loop(func(v *C.uint64_t, n C.int) C.int { return C.bench_bin(v, n) }, vals)
+}
+
+func BenchFloat(vals []float64) int {
+	return int(C.bench_float((*C.double)(unsafe.Pointer(&vals[0])), C.int(len(vals))))
+}
+
+const NumfmtMaxLen = C.NUMFMT_MAX_LEN
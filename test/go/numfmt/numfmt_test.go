@@ -0,0 +1,85 @@
+package numfmt
+
+import (
+	"fmt"
+	"math"
+	"math/rand"
+	"strings"
+	"testing"
+)
+
+// random values of every bit length and the edges of the types
+func testValues(n int) []uint64 {
+	r := rand.New(rand.NewSource(1))
+	vals := []uint64{0, 1, 9, 10, 15, 16, 99, 100, math.MaxInt64, math.MaxInt64 + 1, math.MaxUint64}
+	for len(vals) < n {
+		vals = append(vals, r.Uint64()>>uint(r.Intn(64)))
+	}
+	return vals
+}
+
+// the separators every group digits, counted from the lowest one
+func grouped(digits string, group int) string {
+	if group == 0 {
+		return digits
+	}
+	var b strings.Builder
+	for i, c := range digits {
+		if i > 0 && (len(digits)-i)%group == 0 {
+			b.WriteByte('_')
+		}
+		b.WriteRune(c)
+	}
+	return b.String()
+}
+
+// the C formatters replace these three of HexowlCalculate
+func TestMatchesFmt(t *testing.T) {
+	for _, v := range testValues(200000) {
+		if got, want := Udec(v), fmt.Sprintf("%v", v); got != want {
+			t.Fatalf("udec %d: got %q", v, got)
+		}
+		if got, want := Dec(int64(v)), fmt.Sprintf("%v", int64(v)); got != want {
+			t.Fatalf("dec %d: got %q, want %q", int64(v), got, want)
+		}
+		if got, want := Hex(v), fmt.Sprintf("0x%X", v); got != want {
+			t.Fatalf("hex %#x: got %q, want %q", v, got, want)
+		}
+		for _, group := range []int{0, 4, 8} {
+			want := "0b" + grouped(fmt.Sprintf("%b", v), group)
+			if got := Bin(v, group); got != want {
+				t.Fatalf("bin %#x, group %d: got %q, want %q", v, group, got, want)
+			}
+		}
+	}
+}
+
+func TestLongestFits(t *testing.T) {
+	if got := len(Bin(math.MaxUint64, 4)); got+1 > NumfmtMaxLen {
+		t.Fatalf("longest output %d bytes does not fit NUMFMT_MAX_LEN %d", got+1, NumfmtMaxLen)
+	}
+}
+
+// a result is formatted in all three bases, once per value in the benchmarks below
+
+func BenchmarkC(b *testing.B) {
+	vals := testValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i += len(vals) {
+		n := min(len(vals), b.N-i)
+		BenchUdec(vals[:n])
+		BenchHex(vals[:n])
+		BenchBin(vals[:n])
+	}
+}
+
+func BenchmarkGoSprintf(b *testing.B) {
+	vals := testValues(1024)
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		v := vals[i%len(vals)]
+		_ = fmt.Sprintf("%v", v)
+		_ = fmt.Sprintf("0x%X", v)
+		_ = fmt.Sprintf("0b%b", v)
+	}
+}
@@ -0,0 +1,73 @@
+package hexowltest
+
+import (
+	"fmt"
+	"os"
+	"testing"
+
+	"github.com/dece2183/hexowl/builtin"
+	"github.com/dece2183/hexowl/builtin/types"
+	"github.com/dece2183/hexowl/operators"
+	"github.com/dece2183/hexowl/utils"
+)
+
+func TestMain(m *testing.M) {
+	builtin.SystemInit(types.System{Stdout: os.Stdout})
+	os.Exit(m.Run())
+}
+
+func generate(t testing.TB, input string) *operators.Operator {
+	t.Helper()
+	op, err := operators.Generate(utils.ParsePrompt(input), make(map[string]interface{}))
+	if err != nil {
+		t.Fatalf("%q: %v", input, err)
+	}
+	return op
+}
+
+func calculate(t testing.TB, op *operators.Operator) string {
+	t.Helper()
+	val, err := operators.Calculate(op, make(map[string]interface{}))
+	if err != nil {
+		return "error: " + err.Error()
+	}
+	return fmt.Sprintf("%T %v", val, val)
+}
+
+// the parse cache of the firmware evaluates one generated tree many times,
+// that is only right if Calculate leaves the tree as it was
+func TestCachedTreeIsReusable(t *testing.T) {
+	inputs := []string{
+		"1 + 2 * 3",
+		"(0xFF << 4) | 0b1010",
+		"2 ** 10 / 3",
+		"10 > 3 && 2 < 1",
+		"-(5 - 12) % 4",
+		"1.5 * 4",
+		"sqrt(16) + 1",
+	}
+
+	for _, input := range inputs {
+		cached := generate(t, input)
+		want := calculate(t, generate(t, input))
+		for i := 0; i < 3; i++ {
+			if got := calculate(t, cached); got != want {
+				t.Errorf("%q run %d: got %s, want %s", input, i, got, want)
+			}
+		}
+	}
+}
+
+// an assignment does not flush the cache, so a cached tree must read
+// the variables when it is calculated and not when it is generated
+func TestCachedTreeSeesVariables(t *testing.T) {
+	cached := generate(t, "cachevar * 3 + 1")
+
+	for _, v := range []string{"2", "7", "0x10"} {
+		calculate(t, generate(t, "cachevar = "+v))
+		want := calculate(t, generate(t, "cachevar * 3 + 1"))
+		if got := calculate(t, cached); got != want {
+			t.Errorf("cachevar = %s: got %s, want %s", v, got, want)
+		}
+	}
+}
@@ -0,0 +1,37 @@
+package hexowltest
+
+// #cgo CFLAGS: -O2 -I${SRCDIR}/../../main/calc/fastcalc
+// #include <stdlib.h>
+// #include "fastcalc.h"
+//
+// // the expression evaluated n times in a row, without a cgo call in between
+// static bool fastcalc_bench(const char *expr, int len, int n)
+// {
+//     uint64_t result;
+//     bool ok = true;
+//     for (int i = 0; i < n; ++i)
+//         ok &= fastcalc_eval(expr, len, &result);
+//     return ok;
+// }
+import "C"
+import "unsafe"
+
+// fastcalc evaluates expr with the C fast path of calc.c
+func fastcalc(expr string) (uint64, bool) {
+	var result C.uint64_t
+
+	cexpr := C.CString(expr)
+	defer C.free(unsafe.Pointer(cexpr))
+
+	if !C.fastcalc_eval(cexpr, C.int(len(expr)), &result) {
+		return 0, false
+	}
+	return uint64(result), true
+}
+
+func fastcalcBench(expr string, n int) bool {
+	cexpr := C.CString(expr)
+	defer C.free(unsafe.Pointer(cexpr))
+
+	return bool(C.fastcalc_bench(cexpr, C.int(len(expr)), C.int(n)))
+}
@@ -0,0 +1,131 @@
+package hexowltest
+
+import (
+	"fmt"
+	"math/rand"
+	"strconv"
+	"strings"
+	"testing"
+
+	"github.com/dece2183/hexowl/operators"
+	"github.com/dece2183/hexowl/utils"
+)
+
+var fastcalcOps = []string{"+", "-", "*", "<<", ">>", "&", "|"}
+
+// literals and operators of the fast path, with some that it has to refuse:
+// unary minus, floats, powers, octal looking and oversized literals
+func genLiteral(r *rand.Rand) string {
+	switch r.Intn(12) {
+	case 0:
+		return fmt.Sprintf("0x%X", r.Uint64()>>uint(r.Intn(64)))
+	case 1:
+		return "0b" + strconv.FormatUint(r.Uint64()>>uint(48+r.Intn(16)), 2)
+	case 2:
+		return strconv.FormatUint(r.Uint64(), 10)
+	case 3:
+		return "~" + strconv.Itoa(r.Intn(256))
+	case 4:
+		return []string{"-3", "1.5", "2**3", "010", "1e3", "0x", "x"}[r.Intn(7)]
+	default:
+		return strconv.Itoa(r.Intn(64))
+	}
+}
+
+func genExpr(r *rand.Rand, depth int) string {
+	if depth == 0 || r.Intn(3) == 0 {
+		return genLiteral(r)
+	}
+
+	lhs := genExpr(r, depth-1)
+	rhs := genExpr(r, depth-1)
+	expr := lhs + " " + fastcalcOps[r.Intn(len(fastcalcOps))] + " " + rhs
+	if r.Intn(3) == 0 {
+		expr = "(" + expr + ")"
+	}
+	return expr
+}
+
+func hexowlCalculate(expr string) (string, error) {
+	op, err := operators.Generate(utils.ParsePrompt(expr), make(map[string]interface{}))
+	if err != nil {
+		return "", err
+	}
+	val, err := operators.Calculate(op, make(map[string]interface{}))
+	if err != nil {
+		return "", err
+	}
+	return fmt.Sprintf("%v", val), nil
+}
+
+// every expression the fast path takes has to give the result of hexowl,
+// the ones it refuses go to hexowl anyway
+func TestFastcalcMatchesHexowl(t *testing.T) {
+	r := rand.New(rand.NewSource(4))
+	accepted := 0
+	const count = 100000
+
+	for i := 0; i < count; i++ {
+		expr := genExpr(r, 1+r.Intn(4))
+		fast, ok := fastcalc(expr)
+		if !ok {
+			continue
+		}
+		accepted++
+
+		want, err := hexowlCalculate(expr)
+		if err != nil {
+			t.Fatalf("%q: fast path gives %d, hexowl fails: %v", expr, fast, err)
+		}
+		if got := strconv.FormatUint(fast, 10); got != want {
+			t.Fatalf("%q: fast path gives %s, hexowl %s", expr, got, want)
+		}
+	}
+
+	t.Logf("fast path took %d of %d expressions", accepted, count)
+	if accepted < count/10 {
+		t.Errorf("fast path took only %d of %d expressions", accepted, count)
+	}
+}
+
+func TestFastcalcRefuses(t *testing.T) {
+	inputs := []string{
+		"", " ", "-1", "+1", "1.5", "2**3", "1 && 2", "010", "1e3", "x", "x = 1",
+		"0x8000000000000000", "1 << 64", "0 - 1", "9223372036854775807 + 1",
+		"~0", "(1 + 2", strings.Repeat("(", 17) + "1" + strings.Repeat(")", 17),
+	}
+
+	for _, input := range inputs {
+		if val, ok := fastcalc(input); ok {
+			t.Errorf("%q: fast path took it as %d", input, val)
+		}
+	}
+}
+
+// the expressions people type, one evaluation per op
+
+var benchExprs = []string{"0x1F + 42", "(1 << 12) - 1", "0xDEAD & 0xFF00 | 0b1010", "123456789 * 1000"}
+
+func BenchmarkFastcalc(b *testing.B) {
+	for _, expr := range benchExprs {
+		b.Run(expr, func(b *testing.B) {
+			for i := 0; i < b.N; i += 1000 {
+				if !fastcalcBench(expr, min(1000, b.N-i)) {
+					b.Fatalf("%q: not on the fast path", expr)
+				}
+			}
+		})
+	}
+}
+
+func BenchmarkHexowl(b *testing.B) {
+	for _, expr := range benchExprs {
+		b.Run(expr, func(b *testing.B) {
+			for i := 0; i < b.N; i++ {
+				if _, err := hexowlCalculate(expr); err != nil {
+					b.Fatal(err)
+				}
+			}
+		})
+	}
+}
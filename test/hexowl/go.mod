@@ -0,0 +1,5 @@
+module hard-hexowl-test
+
+go 1.21
+
+require github.com/dece2183/hexowl v1.5.1
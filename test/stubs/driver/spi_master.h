@@ -0,0 +1,19 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <esp_err.h>
+
+typedef int spi_host_device_t;
+typedef struct spi_device_t *spi_device_handle_t;
+
+typedef struct {
+    uint32_t flags;
+    size_t length;
+    void *user;
+    const void *tx_buffer;
+    uint8_t tx_data[4];
+} spi_transaction_t;
+
+#define SPI_TRANS_USE_TXDATA (1 << 3)
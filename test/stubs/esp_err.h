@@ -0,0 +1,8 @@
+#pragma once
+
+// the parts of ESP-IDF the host tests compile against
+
+typedef int esp_err_t;
+
+#define ESP_OK      (0)
+#define ESP_FAIL    (-1)
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DMA      (1 << 3)
+#define MALLOC_CAP_SPIRAM   (1 << 10)
+
+static inline void *heap_caps_malloc(size_t size, unsigned caps)
+{
+    (void)caps;
+    return malloc(size);
+}
+
+static inline void heap_caps_free(void *ptr)
+{
+    free(ptr);
+}
+
+// the host has no PSRAM to plan the Go heap in
+static inline size_t heap_caps_get_free_size(unsigned caps)
+{
+    (void)caps;
+    return 0;
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdarg.h>
+#include <stdio.h>
+
+// errors and warnings go to stderr, so they are in the ctest output of a failed test;
+// the formats are not checked, they are written for the 32 bit size_t of the target
+static inline void esp_log_print(const char *level, const char *tag, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    fprintf(stderr, "%s (%s) ", level, tag);
+    vfprintf(stderr, fmt, args);
+    fputc('\n', stderr);
+    va_end(args);
+}
+
+static inline void esp_log_discard(const char *tag, const char *fmt, ...)
+{
+}
+
+#define ESP_LOGE(tag, fmt, ...) esp_log_print("E", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) esp_log_print("W", tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) esp_log_discard(tag, fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) esp_log_discard(tag, fmt, ##__VA_ARGS__)
@@ -0,0 +1,199 @@
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include <errno.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+struct queue {
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    uint8_t *items;
+    UBaseType_t length;
+    UBaseType_t item_size;
+    UBaseType_t head;
+    UBaseType_t count;
+};
+
+typedef struct {
+    TaskFunction_t func;
+    void *arg;
+} task_start_t;
+
+static uint64_t now_ms(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000 + t.tv_nsec / 1000000;
+}
+
+// false once the ticks have passed, the condition is waited on with the lock held
+static bool wait_changed(struct queue *q, TickType_t wait, const struct timespec *deadline)
+{
+    if (wait == 0)
+        return false;
+    if (wait == portMAX_DELAY)
+        return pthread_cond_wait(&q->changed, &q->lock) == 0;
+    return pthread_cond_timedwait(&q->changed, &q->lock, deadline) != ETIMEDOUT;
+}
+
+static void deadline_after(TickType_t wait, struct timespec *deadline)
+{
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += wait / configTICK_RATE_HZ;
+    deadline->tv_nsec += (long)(wait % configTICK_RATE_HZ) * (1000000000 / configTICK_RATE_HZ);
+    if (deadline->tv_nsec >= 1000000000)
+    {
+        deadline->tv_sec += 1;
+        deadline->tv_nsec -= 1000000000;
+    }
+}
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t item_size)
+{
+    struct queue *q = calloc(1, sizeof(struct queue));
+    if (q == NULL)
+        return NULL;
+
+    if (item_size > 0 && (q->items = malloc(length * item_size)) == NULL)
+    {
+        free(q);
+        return NULL;
+    }
+
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->changed, NULL);
+    q->length = length;
+    q->item_size = item_size;
+    return q;
+}
+
+BaseType_t xQueueSend(QueueHandle_t q, const void *item, TickType_t wait)
+{
+    struct timespec deadline;
+
+    deadline_after(wait, &deadline);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == q->length)
+    {
+        if (!wait_changed(q, wait, &deadline))
+        {
+            pthread_mutex_unlock(&q->lock);
+            return pdFALSE;
+        }
+    }
+
+    if (q->item_size > 0)
+        memcpy(&q->items[(q->head + q->count) % q->length * q->item_size], item, q->item_size);
+    ++q->count;
+
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t q, void *item, TickType_t wait)
+{
+    struct timespec deadline;
+
+    deadline_after(wait, &deadline);
+    pthread_mutex_lock(&q->lock);
+    while (q->count == 0)
+    {
+        if (!wait_changed(q, wait, &deadline))
+        {
+            pthread_mutex_unlock(&q->lock);
+            return pdFALSE;
+        }
+    }
+
+    if (q->item_size > 0)
+        memcpy(item, &q->items[q->head * q->item_size], q->item_size);
+    q->head = (q->head + 1) % q->length;
+    --q->count;
+
+    pthread_cond_broadcast(&q->changed);
+    pthread_mutex_unlock(&q->lock);
+    return pdTRUE;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t q)
+{
+    UBaseType_t count;
+
+    pthread_mutex_lock(&q->lock);
+    count = q->count;
+    pthread_mutex_unlock(&q->lock);
+    return count;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void)
+{
+    return xQueueCreate(1, 0);
+}
+
+SemaphoreHandle_t xSemaphoreCreateMutex(void)
+{
+    SemaphoreHandle_t sem = xQueueCreate(1, 0);
+    if (sem != NULL)
+        xSemaphoreGive(sem);
+    return sem;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial)
+{
+    SemaphoreHandle_t sem = xQueueCreate(max, 0);
+    for (UBaseType_t i = 0; sem != NULL && i < initial; ++i)
+        xSemaphoreGive(sem);
+    return sem;
+}
+
+static void *task_thread(void *arg)
+{
+    task_start_t start = *(task_start_t *)arg;
+
+    free(arg);
+    start.func(start.arg);
+    return NULL;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t func, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *task)
+{
+    task_start_t *start = malloc(sizeof(task_start_t));
+    pthread_t thread;
+
+    if (start == NULL)
+        return pdFALSE;
+
+    start->func = func;
+    start->arg = arg;
+    if (pthread_create(&thread, NULL, task_thread, start) != 0)
+    {
+        free(start);
+        return pdFALSE;
+    }
+
+    pthread_detach(thread);
+    if (task != NULL)
+        *task = (TaskHandle_t)(uintptr_t)thread;
+    return pdPASS;
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    return (TickType_t)now_ms();
+}
+
+void vTaskDelay(TickType_t ticks)
+{
+    struct timespec t = {
+        .tv_sec = ticks / configTICK_RATE_HZ,
+        .tv_nsec = (long)(ticks % configTICK_RATE_HZ) * (1000000000 / configTICK_RATE_HZ),
+    };
+    nanosleep(&t, NULL);
+}
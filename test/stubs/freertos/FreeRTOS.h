@@ -0,0 +1,16 @@
+#pragma once
+
+#include <stdint.h>
+
+// FreeRTOS on POSIX threads, with the 1 kHz tick of sdkconfig
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+
+#define configTICK_RATE_HZ  (1000)
+#define portMAX_DELAY       ((TickType_t)0xFFFFFFFF)
+#define pdFALSE             (0)
+#define pdTRUE              (1)
+#define pdPASS              (pdTRUE)
+#define pdMS_TO_TICKS(ms)   ((TickType_t)((uint64_t)(ms) * configTICK_RATE_HZ / 1000))
@@ -0,0 +1,13 @@
+#pragma once
+
+#include "queue.h"
+
+// a semaphore is a queue of items without data, as in FreeRTOS
+typedef QueueHandle_t SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateBinary(void);
+SemaphoreHandle_t xSemaphoreCreateMutex(void);
+SemaphoreHandle_t xSemaphoreCreateCounting(UBaseType_t max, UBaseType_t initial);
+
+#define xSemaphoreTake(sem, wait)   xQueueReceive((sem), NULL, (wait))
+#define xSemaphoreGive(sem)         xQueueSend((sem), NULL, 0)
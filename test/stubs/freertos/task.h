@@ -0,0 +1,11 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+typedef void (*TaskFunction_t)(void *arg);
+typedef struct task *TaskHandle_t;
+
+// the task runs in a detached thread, the stack size and the priority are ignored
+BaseType_t xTaskCreate(TaskFunction_t func, const char *name, uint32_t stack, void *arg, UBaseType_t priority, TaskHandle_t *task);
+TickType_t xTaskGetTickCount(void);
+void vTaskDelay(TickType_t ticks);
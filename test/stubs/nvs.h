@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+#include <esp_err.h>
+
+// there is no flash on the host, every open fails as on an erased partition
+typedef uint32_t nvs_handle_t;
+
+typedef enum {
+    NVS_READONLY,
+    NVS_READWRITE,
+} nvs_open_mode_t;
+
+static inline esp_err_t nvs_open(const char *name, nvs_open_mode_t mode, nvs_handle_t *handle)
+{
+    return ESP_FAIL;
+}
+
+static inline esp_err_t nvs_get_u32(nvs_handle_t handle, const char *key, uint32_t *value)
+{
+    return ESP_FAIL;
+}
+
+static inline esp_err_t nvs_set_u32(nvs_handle_t handle, const char *key, uint32_t value)
+{
+    return ESP_FAIL;
+}
+
+static inline esp_err_t nvs_commit(nvs_handle_t handle)
+{
+    return ESP_FAIL;
+}
+
+static inline void nvs_close(nvs_handle_t handle)
+{
+}
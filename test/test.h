@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdio.h>
+
+// every test is a program of its own, it reports the failed checks and
+// returns their count, so ctest sees a failure as a nonzero exit code
+static int test_failures;
+
+#define CHECK(cond)                                                         \
+    do                                                                      \
+    {                                                                       \
+        if (!(cond))                                                        \
+        {                                                                   \
+            fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #cond);      \
+            ++test_failures;                                                \
+        }                                                                   \
+    } while (0)
@@ -0,0 +1,152 @@
+#!/usr/bin/env python3
+"""Pack a 4bpp bitmap font source into the cropped font_pack_t format.
+
+The input is a font generated for the ssd1322 driver (see
+main/display/fonts/cascadia_font.c). Every glyph is cropped to the bounding
+box of its pixels, blank rows inside the box are skipped, and the result is
+decoded back and compared with the source before anything is written.
+
+usage: fontpack.py <font.c> <font.h> <name> <output dir>
+"""
+
+import os
+import re
+import sys
+
+MAX_ROWS = 16
+
+BITMAP_RE = re.compile(r"__font_\w+?_ch_(\d+)_bmp\[\]\s*=\s*\{([^}]*)\}")
+CHAR_RE = re.compile(r"\[(\d+)\]\s*=\s*\{\s*\.bitmap\s*=\s*__font_\w+?_ch_(\d+)_bmp,\s*\.w\s*=\s*(\d+),\s*\.h\s*=\s*(\d+),")
+RANGE_RE = re.compile(r"\.first_index\s*=\s*(\d+),\s*\.last_index\s*=\s*(\d+),")
+LICENSE_RE = re.compile(r"/\*.*?\*/", re.S)
+
+
+def parse_font(source):
+    bitmaps = {int(code): bytes(int(b, 16) for b in body.replace(",", " ").split())
+               for code, body in BITMAP_RE.findall(source)}
+    chars = {int(idx): (bitmaps[int(code)], int(w), int(h))
+             for idx, code, w, h in CHAR_RE.findall(source)}
+    first, last = (int(v) for v in RANGE_RE.search(source).groups())
+    return chars, first, last
+
+
+def pixels(bitmap, w, h):
+    """cell pixels, a row takes w/2 bytes with the left pixel in the high nibble"""
+    stride = (w + 1) // 2
+    return [[(bitmap[y * stride + x // 2] >> (0 if x % 2 else 4)) & 0x0F for x in range(w)]
+            for y in range(h)]
+
+
+def pack_glyph(px, w, h):
+    used_rows = [y for y in range(h) if any(px[y])]
+    used_cols = [x for x in range(w) if any(px[y][x] for y in range(h))]
+    if not used_rows:
+        return dict(top=0, rows=0, left=0, bytes=0, row_mask=0, data=b"")
+
+    top, bottom = used_rows[0], used_rows[-1]
+    # an even left column keeps the stored bytes aligned with the framebuffer
+    left = used_cols[0] & ~1
+    right = used_cols[-1]
+    nbytes = (right - left) // 2 + 1
+    rows = bottom - top + 1
+    if rows > MAX_ROWS:
+        sys.exit("glyph box is taller than %d rows" % MAX_ROWS)
+
+    mask = 0
+    data = bytearray()
+    for r in range(rows):
+        row = px[top + r]
+        if not any(row):
+            continue
+        mask |= 1 << r
+        for i in range(nbytes):
+            x = left + i * 2
+            hi = row[x] if x < w else 0
+            lo = row[x + 1] if x + 1 < w else 0
+            data.append(hi << 4 | lo)
+
+    return dict(top=top, rows=rows, left=left, bytes=nbytes, row_mask=mask, data=bytes(data))
+
+
+def unpack_glyph(g, w, h):
+    """same as font_pack_row in font_pack.c"""
+    px = [[0] * w for _ in range(h)]
+    for r in range(g["rows"]):
+        bit = 1 << r
+        if not g["row_mask"] & bit:
+            continue
+        offset = bin(g["row_mask"] & (bit - 1)).count("1") * g["bytes"]
+        for i in range(g["bytes"]):
+            b = g["data"][offset + i]
+            for n, v in enumerate((b >> 4, b & 0x0F)):
+                x = g["left"] + i * 2 + n
+                if x < w:
+                    px[g["top"] + r][x] = v
+    return px
+
+
+def c_bytes(data, indent="\t", per_line=32):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ",".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def main():
+    if len(sys.argv) != 5:
+        sys.exit(__doc__)
+
+    font_c, font_h, name, out_dir = sys.argv[1:]
+    with open(font_c) as f:
+        chars, first, last = parse_font(f.read())
+    with open(font_h) as f:
+        license = LICENSE_RE.search(f.read()).group(0)
+
+    glyphs = []
+    data = bytearray()
+    original = 0
+    for code in range(first, last + 1):
+        bitmap, w, h = chars[code]
+        original += len(bitmap)
+        px = pixels(bitmap, w, h)
+        g = pack_glyph(px, w, h)
+        if unpack_glyph(g, w, h) != px:
+            sys.exit("glyph 0x%02X does not survive the round trip" % code)
+        g.update(code=code, w=w, h=h, offset=len(data))
+        data += g["data"]
+        glyphs.append(g)
+
+    if len(data) > 0xFFFF:
+        sys.exit("font data does not fit 16 bit offsets")
+
+    glyph_size = 10
+    total = len(data) + len(glyphs) * glyph_size
+    usage = ("//\t%s packed font\n//\n//\tMemory usage\n//\t\tData: %d\n//\t\tGlyph descriptors: %d\n"
+             "//\n//\t\tTotal: %d (source bitmaps: %d)\n//\n") % (name, len(data), len(glyphs) * glyph_size, total, original)
+
+    with open(os.path.join(out_dir, "%s_pack.h" % name), "w") as f:
+        f.write("#pragma once\n\n%s\n\n#include \"font_pack.h\"\n\n" % license)
+        f.write("// generated by tools/fontpack.py from %s\n" % os.path.basename(font_c))
+        f.write("extern const font_pack_t %s_pack;\n" % name)
+
+    with open(os.path.join(out_dir, "%s_pack.c" % name), "w") as f:
+        f.write(usage + "\n#include \"%s_pack.h\"\n\n" % name)
+        f.write("static const uint8_t __font_%s_pack_data[] = {\n" % name)
+        for g in glyphs:
+            if g["data"]:
+                f.write("\t// %r (0x%02X)\n%s\n" % (chr(g["code"]), g["code"], c_bytes(g["data"])))
+        f.write("};\n\n")
+        f.write("static const font_pack_glyph_t __font_%s_pack_glyphs[] = {\n" % name)
+        for g in glyphs:
+            f.write("\t// %r (0x%02X)\n" % (chr(g["code"]), g["code"]))
+            f.write("\t{.offset = %d, .w = %d, .h = %d, .top = %d, .rows = %d, .left = %d, .bytes = %d, .row_mask = 0x%04X},\n"
+                    % (g["offset"], g["w"], g["h"], g["top"], g["rows"], g["left"], g["bytes"], g["row_mask"]))
+        f.write("};\n\n")
+        f.write("const font_pack_t %s_pack = {\n\t.data = __font_%s_pack_data,\n\t.glyphs = __font_%s_pack_glyphs,\n"
+                "\t.first = %d,\n\t.last = %d,\n};\n" % (name, name, name, first, last))
+
+    print("%s: %d glyphs, %d bytes (source bitmaps %d bytes)" % (name, len(glyphs), total, original))
+
+
+if __name__ == "__main__":
+    main()